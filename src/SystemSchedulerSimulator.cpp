@@ -1,428 +1,6471 @@
-// SystemSchedulerSimulator.cpp
-// Professional CPU Scheduling Simulator (C++17)
-// Implements FCFS, SRTF (preemptive), Preemptive Priority, and Round Robin
-// Simulates time (no real threads/sleep). Produces Gantt chart and metrics.
-//
-// Compile: g++ -std=c++17 SystemSchedulerSimulator.cpp -O2 -o scheduler
-// Run: ./scheduler
-//
-#include <bits/stdc++.h>
-using namespace std;
-
-struct Process {
-    int pid = 0;
-    int arrival = 0;
-    int burst = 0;
-    int remaining = 0;
-    int priority = 0;         // Lower value = higher priority
-    int start = -1;           // First time it got CPU
-    int completion = -1;
-    // Derived metrics
-    int waiting = 0;
-    int turnaround = 0;
-    int response = -1;
-};
-
-using Timeline = vector<int>; // pid at each time unit, 0 for idle
-
-// Utility: print a nice Gantt chart with time ticks
-void printGantt(const Timeline &g) {
-    cout << "\nGantt Chart:\n";
-    // First line: process symbols
-    cout << "|";
-    for (size_t t = 0; t < g.size(); ++t) {
-        if (g[t] == 0) cout << " Idle |";
-        else {
-            cout << " P" << g[t] << "  |";
-        }
-    }
-    cout << "\n";
-    // Time ticks
-    cout << "0";
-    for (size_t t = 0; t < g.size(); ++t) {
-        cout << setw(6) << (t + 1);
-    }
-    cout << "\n\n";
-}
-
-// Compute and print metrics for final processes and timeline
-void computeAndPrintMetrics(vector<Process> procs, const Timeline &g) {
-    int n = (int)procs.size();
-    double totalWT = 0, totalTAT = 0, totalResp = 0;
-    int totalBurst = 0;
-    int completed = 0;
-    int lastTime = (int)g.size();
-    int contextSwitches = 0;
-    int prevPID = -1;
-
-    for (int t = 0; t < (int)g.size(); ++t) {
-        if ((int)g[t] != prevPID) {
-            if (t > 0 && prevPID != 0) contextSwitches++;
-            prevPID = g[t];
-        }
-    }
-
-    for (auto &p : procs) {
-        p.turnaround = p.completion - p.arrival;
-        p.waiting = p.turnaround - p.burst;
-        if (p.response < 0) p.response = p.start - p.arrival;
-        totalWT += p.waiting;
-        totalTAT += p.turnaround;
-        totalResp += p.response;
-        totalBurst += p.burst;
-        if (p.completion >= 0) completed++;
-        cout << "P" << p.pid << " : Arrival=" << p.arrival
-             << ", Burst=" << p.burst
-             << ", Priority=" << p.priority
-             << ", Start=" << p.start
-             << ", Completion=" << p.completion
-             << ", WT=" << p.waiting
-             << ", TAT=" << p.turnaround
-             << ", Resp=" << p.response << "\n";
-    }
-
-    cout << fixed << setprecision(3);
-    cout << "\nSummary:\n";
-    cout << "Avg Waiting Time  = " << (totalWT / n) << "\n";
-    cout << "Avg Turnaround    = " << (totalTAT / n) << "\n";
-    cout << "Avg Response Time = " << (totalResp / n) << "\n";
-    cout << "Context Switches  = " << contextSwitches << "\n";
-    cout << "Throughput (proc/unit time) = " << (double)completed / max(1, lastTime) << "\n";
-    cout << "CPU Utilization = " << (double)totalBurst / max(1, lastTime) * 100.0 << " %\n\n";
-}
-
-// Reset helpers
-void resetProcesses(vector<Process> &procs) {
-    for (auto &p : procs) {
-        p.remaining = p.burst;
-        p.start = -1;
-        p.completion = -1;
-        p.waiting = 0;
-        p.turnaround = 0;
-        p.response = -1;
-    }
-}
-
-// FCFS - Non-preemptive (time simulated)
-Timeline FCFS(vector<Process> procs) {
-    cout << "=== FCFS (Non-preemptive) ===\n";
-    int cur = 0;
-    Timeline gantt;
-    // sort by arrival then pid
-    sort(procs.begin(), procs.end(), [](const Process &a, const Process &b){
-        if (a.arrival != b.arrival) return a.arrival < b.arrival;
-        return a.pid < b.pid;
-    });
-    for (auto &p : procs) {
-        if (cur < p.arrival) {
-            // CPU idle until arrival
-            while (cur < p.arrival) { gantt.push_back(0); cur++; }
-        }
-        // start if first time
-        if (p.start == -1) p.start = cur, p.response = p.start - p.arrival;
-        // run to completion
-        for (int i = 0; i < p.burst; ++i) {
-            gantt.push_back(p.pid);
-            cur++;
-        }
-        p.completion = cur;
-    }
-    // compute completion times back into procs vector used to compute metrics
-    // note: copy was by value so compute metrics directly here by mapping
-    // For simplicity, recompute metrics by reconstructing using pid
-    // Reconstruct final procs with computed completion/start info
-    // We'll compute metrics by re-running a mapping
-    // Build map pid->process info from last run
-    // To keep consistent, we'll recompute metrics outside using original ordering:
-    // For that, we need procs with up-to-date fields, so return gantt and compute using helper:
-    // But helper expects procs with completion/start fields; as we modified local procs, it's fine.
-    computeAndPrintMetrics(procs, gantt);
-    printGantt(gantt);
-    return gantt;
-}
-
-// SRTF (Shortest Remaining Time First) - preemptive, 1-unit tick simulation
-Timeline SRTF(vector<Process> procs) {
-    cout << "=== SRTF (Preemptive SJF) ===\n";
-    int n = (int)procs.size();
-    Timeline gantt;
-    int completed = 0;
-    int cur = 0;
-    // Keep processes in original order but refer by index
-    resetProcesses(procs);
-
-    while (completed < n) {
-        // find index with minimum remaining among arrived
-        int idx = -1, minRem = INT_MAX;
-        for (int i = 0; i < n; ++i) {
-            if (procs[i].arrival <= cur && procs[i].remaining > 0) {
-                if (procs[i].remaining < minRem) {
-                    minRem = procs[i].remaining;
-                    idx = i;
-                }
-            }
-        }
-        if (idx == -1) {
-            // idle
-            gantt.push_back(0);
-            cur++;
-            continue;
-        }
-        // if first time on CPU
-        if (procs[idx].start == -1) {
-            procs[idx].start = cur;
-            procs[idx].response = procs[idx].start - procs[idx].arrival;
-        }
-        // execute 1 unit
-        gantt.push_back(procs[idx].pid);
-        procs[idx].remaining -= 1;
-        cur++;
-        if (procs[idx].remaining == 0) {
-            procs[idx].completion = cur;
-            completed++;
-        }
-    }
-
-    computeAndPrintMetrics(procs, gantt);
-    printGantt(gantt);
-    return gantt;
-}
-
-// Preemptive Priority Scheduling (lower number = higher priority)
-Timeline PreemptivePriority(vector<Process> procs) {
-    cout << "=== Preemptive Priority Scheduling ===\n";
-    int n = (int)procs.size();
-    Timeline gantt;
-    int completed = 0;
-    int cur = 0;
-    resetProcesses(procs);
-
-    while (completed < n) {
-        int idx = -1, bestPr = INT_MAX;
-        for (int i = 0; i < n; ++i) {
-            if (procs[i].arrival <= cur && procs[i].remaining > 0) {
-                if (procs[i].priority < bestPr) {
-                    bestPr = procs[i].priority;
-                    idx = i;
-                } else if (procs[i].priority == bestPr) {
-                    // tie-breaker: lower remaining burst or earlier arrival
-                    if (idx == -1 || procs[i].remaining < procs[idx].remaining) idx = i;
-                }
-            }
-        }
-        if (idx == -1) { gantt.push_back(0); cur++; continue; }
-        if (procs[idx].start == -1) {
-            procs[idx].start = cur;
-            procs[idx].response = procs[idx].start - procs[idx].arrival;
-        }
-        // execute 1 unit
-        gantt.push_back(procs[idx].pid);
-        procs[idx].remaining -= 1;
-        cur++;
-        if (procs[idx].remaining == 0) {
-            procs[idx].completion = cur;
-            completed++;
-        }
-    }
-
-    computeAndPrintMetrics(procs, gantt);
-    printGantt(gantt);
-    return gantt;
-}
-
-// Round Robin scheduling (time quantum tq)
-Timeline RoundRobin(vector<Process> procs, int tq) {
-    cout << "=== Round Robin (Quantum=" << tq << ") ===\n";
-    int n = (int)procs.size();
-    Timeline gantt;
-    queue<int> q;
-    vector<bool> inQ(n, false);
-    int cur = 0, completed = 0;
-    resetProcesses(procs);
-
-    while (completed < n) {
-        // enqueue newly arrived processes
-        for (int i = 0; i < n; ++i) {
-            if (!inQ[i] && procs[i].arrival <= cur && procs[i].remaining > 0) {
-                q.push(i);
-                inQ[i] = true;
-            }
-        }
-
-        if (q.empty()) {
-            // CPU idle
-            gantt.push_back(0);
-            cur++;
-            continue;
-        }
-
-        int idx = q.front(); q.pop();
-        // If first time scheduled
-        if (procs[idx].start == -1) {
-            procs[idx].start = cur;
-            procs[idx].response = procs[idx].start - procs[idx].arrival;
-        }
-        int exec = min(tq, procs[idx].remaining);
-        for (int i = 0; i < exec; ++i) {
-            gantt.push_back(procs[idx].pid);
-            procs[idx].remaining -= 1;
-            cur++;
-            // enqueue new arrivals that come while CPU is executing
-            for (int j = 0; j < n; ++j) {
-                if (!inQ[j] && procs[j].arrival <= cur && procs[j].remaining > 0) {
-                    q.push(j);
-                    inQ[j] = true;
-                }
-            }
-        }
-        if (procs[idx].remaining > 0) {
-            q.push(idx);
-        } else {
-            procs[idx].completion = cur;
-            completed++;
-        }
-    }
-
-    computeAndPrintMetrics(procs, gantt);
-    printGantt(gantt);
-    return gantt;
-}
-
-// Utility to read processes from console
-vector<Process> readFromConsole() {
-    int n;
-    while (true) {
-        cout << "Enter number of processes: ";
-        if (cin >> n && n > 0) break;
-        cout << "Invalid input. Enter a positive integer.\n";
-        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    }
-    vector<Process> procs(n);
-    for (int i = 0; i < n; ++i) {
-        procs[i].pid = i + 1;
-        cout << "=== Process " << procs[i].pid << " ===\n";
-        cout << "Arrival time: "; cin >> procs[i].arrival;
-        cout << "Burst time  : "; cin >> procs[i].burst;
-        cout << "Priority    : "; cin >> procs[i].priority;
-        procs[i].remaining = procs[i].burst;
-    }
-    return procs;
-}
-
-// Optionally read CSV file: pid,arrival,burst,priority (pid optional)
-vector<Process> readFromCSV(const string &path) {
-    ifstream fin(path);
-    if (!fin.is_open()) {
-        cerr << "Failed to open CSV file: " << path << "\n";
-        return {};
-    }
-    vector<Process> procs;
-    string line;
-    // attempt to skip header if exists
-    if (!getline(fin, line)) return procs;
-    // check if header contains non-digit letters
-    bool header = false;
-    for (char c : line) if (isalpha(c)) header = true;
-    if (!header) {
-        // first line is data; process it
-        stringstream ss(line);
-        vector<int> vals;
-        string tok;
-        while (getline(ss, tok, ',')) vals.push_back(stoi(tok));
-        Process p;
-        if (vals.size() == 3) { p.pid = (int)procs.size() + 1; p.arrival = vals[0]; p.burst = vals[1]; p.priority = vals[2]; }
-        else if (vals.size() == 4) { p.pid = vals[0]; p.arrival = vals[1]; p.burst = vals[2]; p.priority = vals[3]; }
-        else throw runtime_error("CSV format invalid. Expected 3 or 4 columns.");
-        p.remaining = p.burst;
-        procs.push_back(p);
-    }
-    while (getline(fin, line)) {
-        if (line.size() == 0) continue;
-        stringstream ss(line);
-        vector<int> vals;
-        string tok;
-        while (getline(ss, tok, ',')) vals.push_back(stoi(tok));
-        Process p;
-        if (vals.size() == 3) { p.pid = (int)procs.size() + 1; p.arrival = vals[0]; p.burst = vals[1]; p.priority = vals[2]; }
-        else if (vals.size() == 4) { p.pid = vals[0]; p.arrival = vals[1]; p.burst = vals[2]; p.priority = vals[3]; }
-        else throw runtime_error("CSV format invalid. Expected 3 or 4 columns.");
-        p.remaining = p.burst;
-        procs.push_back(p);
-    }
-    return procs;
-}
-
-int main() {
-    ios::sync_with_stdio(false);
-    cin.tie(nullptr);
-
-    cout << "System Scheduler Simulator - Professional Edition (C++17)\n";
-    cout << "Options:\n1) Input from console\n2) Input from CSV file (pid,arrival,burst,priority)\nChoose input mode (1/2): ";
-    int mode;
-    cin >> mode;
-    vector<Process> procs;
-    if (mode == 2) {
-        cout << "Enter CSV file path: ";
-        string path; cin >> path;
-        procs = readFromCSV(path);
-        if (procs.empty()) {
-            cout << "Failed to read CSV or file empty. Exiting.\n";
-            return 1;
-        }
-    } else {
-        procs = readFromConsole();
-    }
-
-    // Sort by pid to preserve consistent reporting
-    sort(procs.begin(), procs.end(), [](const Process &a, const Process &b){ return a.pid < b.pid; });
-
-    // Provide an option to run all algorithms or selected ones
-    cout << "\nSelect algorithms to run (e.g., 1 2 3 4) or 0 for all:\n"
-         << "1: FCFS\n2: SRTF (preemptive SJF)\n3: Preemptive Priority\n4: Round Robin\nChoice: ";
-    string line;
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    getline(cin, line);
-    vector<int> choices;
-    if (line.empty() || line == "0") { choices = {1,2,3,4}; }
-    else {
-        stringstream ss(line);
-        int x;
-        while (ss >> x) choices.push_back(x);
-    }
-
-    // Run chosen algorithms
-    for (int c : choices) {
-        if (c == 1) {
-            auto copyP = procs;
-            resetProcesses(copyP);
-            FCFS(copyP);
-            cout << "---------------------------------------------\n";
-        } else if (c == 2) {
-            auto copyP = procs;
-            resetProcesses(copyP);
-            SRTF(copyP);
-            cout << "---------------------------------------------\n";
-        } else if (c == 3) {
-            auto copyP = procs;
-            resetProcesses(copyP);
-            PreemptivePriority(copyP);
-            cout << "---------------------------------------------\n";
-        } else if (c == 4) {
-            auto copyP = procs;
-            resetProcesses(copyP);
-            int tq;
-            cout << "Enter time quantum for Round Robin (positive integer): ";
-            while (!(cin >> tq) || tq <= 0) {
-                cout << "Invalid quantum. Enter positive integer: ";
-                cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            }
-            RoundRobin(copyP, tq);
-            cout << "---------------------------------------------\n";
-        } else {
-            cout << "Unknown choice: " << c << "\n";
-        }
-    }
-
-    cout << "Simulation complete.\n";
-    return 0;
-}
+// SystemSchedulerSimulator.cpp
+// Professional CPU Scheduling Simulator (C++17)
+// Implements FCFS, SRTF (preemptive), Preemptive Priority, and Round Robin
+// Simulates time (no real threads/sleep). Produces Gantt chart and metrics.
+//
+// Compile: g++ -std=c++17 SystemSchedulerSimulator.cpp -O2 -pthread -o scheduler
+// (-std=c++20 adds scripted processes written as coroutines)
+// Run: ./scheduler
+//
+#include <bits/stdc++.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#if __cplusplus >= 202002L
+#include <coroutine>
+#endif
+using namespace std;
+
+struct Process {
+    int pid = 0;
+    int arrival = 0;
+    int burst = 0;
+    int remaining = 0;
+    int priority = 0;         // Lower value = higher priority
+    int start = -1;           // First time it got CPU
+    int completion = -1;
+    // Derived metrics
+    int waiting = 0;
+    int turnaround = 0;
+    int response = -1;
+    // Delay breakdown (event engine): waiting = queueing + preempted + switchOverhead
+    int queueing = 0;         // arrival until first dispatch
+    int preempted = 0;        // ready but not running after the first dispatch
+    int switchOverhead = 0;   // context-switch time paid before this process could run
+    int cls = 0;              // request class / tenant, index into classNames
+    double memIntensity = 0;  // share of the solo run stalled on memory (interference model)
+};
+
+// Request classes seen in the input; untagged workloads have the single class "default"
+vector<string> classNames = {"default"};
+
+int classIndex(const string &name) {
+    for (size_t c = 0; c < classNames.size(); ++c)
+        if (classNames[c] == name) return (int)c;
+    classNames.push_back(name);
+    return (int)classNames.size() - 1;
+}
+
+using Timeline = vector<int>; // pid at each time unit, 0 for idle, -1 for context-switch overhead
+
+int contextSwitchCost = 0; // time units charged per dispatch of a different process (--switch-cost)
+int preemptThreshold = 0;  // SRTF/Priority: a newcomer must beat the running key by more than this (--preempt-threshold)
+int minGranularity = 0;    // SRTF/Priority: minimum run time before a dispatch can be preempted (--min-granularity)
+
+// The tick simulators implement none of the tuning knobs above
+bool engineTuned() {
+    return contextSwitchCost > 0 || preemptThreshold > 0 || minGranularity > 0;
+}
+
+// Runs a menu algorithm quietly through the selected engine (defined below)
+Timeline runPolicyQuiet(int choice, vector<Process> &procs, int tq);
+
+// Utility: print a nice Gantt chart with time ticks
+void printGantt(const Timeline &g) {
+    cout << "\nGantt Chart:\n";
+    // First line: process symbols
+    cout << "|";
+    for (size_t t = 0; t < g.size(); ++t) {
+        if (g[t] == 0) cout << " Idle |";
+        else if (g[t] < 0) cout << " CS  |";
+        else {
+            cout << " P" << g[t] << "  |";
+        }
+    }
+    cout << "\n";
+    // Time ticks
+    cout << "0";
+    for (size_t t = 0; t < g.size(); ++t) {
+        cout << setw(6) << (t + 1);
+    }
+    cout << "\n\n";
+}
+
+// Aggregate metrics for one run
+struct Metrics {
+    double avgWaiting = 0;
+    double avgTurnaround = 0;
+    double avgResponse = 0;
+    int contextSwitches = 0;
+    double throughput = 0;
+    double utilization = 0;   // percent
+    int completed = 0;
+    int makespan = 0;
+};
+
+// Lower bounds over all schedules of a workload (defined below)
+struct LowerBounds {
+    double avgTurnaround = 0;
+    double makespan = 0;
+};
+
+LowerBounds workloadBounds(const vector<Process> &procs, int cpus = 1);
+
+// Count context switches in a timeline (a switch is any change away from a running process)
+int countContextSwitches(const Timeline &g) {
+    int contextSwitches = 0;
+    int prevPID = -1;
+    for (int t = 0; t < (int)g.size(); ++t) {
+        if ((int)g[t] != prevPID) {
+            if (t > 0 && prevPID > 0) contextSwitches++;
+            prevPID = g[t];
+        }
+    }
+    return contextSwitches;
+}
+
+// Fill derived per-process fields and compute the summary metrics (no output)
+Metrics computeMetrics(vector<Process> &procs, int makespan, int contextSwitches) {
+    Metrics m;
+    int n = (int)procs.size();
+    double totalWT = 0, totalTAT = 0, totalResp = 0;
+    long long totalBurst = 0;
+    int lastTime = makespan;
+
+    for (auto &p : procs) {
+        p.turnaround = p.completion - p.arrival;
+        p.waiting = p.turnaround - p.burst;
+        if (p.response < 0) p.response = p.start - p.arrival;
+        totalWT += p.waiting;
+        totalTAT += p.turnaround;
+        totalResp += p.response;
+        totalBurst += p.burst;
+        if (p.completion >= 0) m.completed++;
+    }
+    m.avgWaiting = totalWT / n;
+    m.avgTurnaround = totalTAT / n;
+    m.avgResponse = totalResp / n;
+    m.contextSwitches = contextSwitches;
+    m.makespan = lastTime;
+    m.throughput = (double)m.completed / max(1, lastTime);
+    m.utilization = (double)totalBurst / max(1, lastTime) * 100.0;
+    return m;
+}
+
+Metrics computeMetrics(vector<Process> &procs, const Timeline &g) {
+    return computeMetrics(procs, (int)g.size(), countContextSwitches(g));
+}
+
+void printSummary(const Metrics &m, const LowerBounds *lb = nullptr) {
+    cout << fixed << setprecision(3);
+    cout << "\nSummary:\n";
+    cout << "Avg Waiting Time  = " << m.avgWaiting << "\n";
+    cout << "Avg Turnaround    = " << m.avgTurnaround << "\n";
+    cout << "Avg Response Time = " << m.avgResponse << "\n";
+    cout << "Context Switches  = " << m.contextSwitches << "\n";
+    cout << "Throughput (proc/unit time) = " << m.throughput << "\n";
+    cout << "CPU Utilization = " << m.utilization << " %\n";
+    if (lb) {
+        cout << "Lower bound Avg Turnaround = " << lb->avgTurnaround << " (SRPT), gap "
+             << (lb->avgTurnaround > 0 ? (m.avgTurnaround / lb->avgTurnaround - 1) * 100 : 0.0) << " %\n";
+        cout << "Lower bound Makespan = " << lb->makespan << ", gap "
+             << (lb->makespan > 0 ? (m.makespan / lb->makespan - 1) * 100 : 0.0) << " %\n";
+    }
+    cout << "\n";
+}
+
+// Compute and print metrics for final processes and timeline
+void computeAndPrintMetrics(vector<Process> procs, const Timeline &g) {
+    Metrics m = computeMetrics(procs, g);
+
+    for (auto &p : procs) {
+        cout << "P" << p.pid << " : Arrival=" << p.arrival
+             << ", Burst=" << p.burst
+             << ", Priority=" << p.priority
+             << ", Start=" << p.start
+             << ", Completion=" << p.completion
+             << ", WT=" << p.waiting
+             << ", TAT=" << p.turnaround
+             << ", Resp=" << p.response;
+        if (classNames.size() > 1) cout << ", Class=" << classNames[p.cls];
+        cout << "\n";
+    }
+
+    LowerBounds lb = workloadBounds(procs);
+    printSummary(m, &lb);
+}
+
+// Reset helpers
+void resetProcesses(vector<Process> &procs) {
+    for (auto &p : procs) {
+        p.remaining = p.burst;
+        p.start = -1;
+        p.completion = -1;
+        p.waiting = 0;
+        p.turnaround = 0;
+        p.response = -1;
+        p.queueing = 0;
+        p.preempted = 0;
+        p.switchOverhead = 0;
+    }
+}
+
+// Random open workload: Poisson arrivals at the rate that gives the requested
+// offered load, uniform bursts in [1, maxBurst], priorities in [0, priorityLevels)
+vector<Process> generateWorkload(int n, double load, int maxBurst, int priorityLevels, unsigned seed) {
+    mt19937 rng(seed);
+    double meanBurst = (1.0 + maxBurst) / 2.0;
+    exponential_distribution<double> gap(load / meanBurst);
+    uniform_int_distribution<int> burst(1, maxBurst), prio(0, max(1, priorityLevels) - 1);
+    vector<Process> procs(n);
+    double t = 0;
+    for (int i = 0; i < n; ++i) {
+        procs[i].pid = i + 1;
+        procs[i].arrival = (int)t;
+        procs[i].burst = burst(rng);
+        procs[i].priority = prio(rng);
+        procs[i].remaining = procs[i].burst;
+        t += gap(rng);
+    }
+    return procs;
+}
+
+// ---------------------------------------------------------------------------
+// Ready-queue operation trace
+// ---------------------------------------------------------------------------
+// The tick-based policies scan the process table instead of keeping a queue, so
+// the trace records the logical operations a queue-based dispatcher performs to
+// produce the same schedule. Keys are unique, so extract-min is deterministic.
+
+enum class RQOpType : char { Insert, ExtractMin, DecreaseKey, Remove };
+
+struct RQOp {
+    RQOpType type;
+    int id;          // index into the policy's process vector
+    long long key;   // new key for Insert/DecreaseKey; the expected key for ExtractMin
+};
+
+vector<RQOp> *rqTrace = nullptr; // when set, policies append their ready-queue operations
+
+// Pack (major, minor) into one ordered key. minor is a non-negative int and major
+// at most two ints apart from zero, so any int inputs fit; every ready queue breaks
+// key ties on the process index, which therefore needs no bits of its own.
+const int rqMinorBits = 31;
+inline long long rqKey(long long major, long long minor) {
+    return major * (1LL << rqMinorBits) + minor;
+}
+
+struct RQTracer {
+    vector<RQOp> *out = rqTrace;
+    vector<int> byArrival;     // indices in arrival order, admitted as time passes
+    size_t nextArrival = 0;
+    int running = -1;
+    vector<long long> keys;
+
+    explicit RQTracer(const vector<Process> &procs) {
+        if (!out) return;
+        byArrival.resize(procs.size());
+        iota(byArrival.begin(), byArrival.end(), 0);
+        stable_sort(byArrival.begin(), byArrival.end(), [&](int a, int b){ return procs[a].arrival < procs[b].arrival; });
+        keys.assign(procs.size(), 0);
+    }
+    void insert(int i, long long key) {
+        if (!out) return;
+        keys[i] = key;
+        out->push_back({RQOpType::Insert, i, key});
+    }
+    void extract(int i) {
+        if (!out) return;
+        out->push_back({RQOpType::ExtractMin, i, keys[i]});
+    }
+    // Insert every process that has arrived by `cur`
+    template <class KeyFn> void admit(const vector<Process> &procs, int cur, KeyFn key) {
+        if (!out) return;
+        while (nextArrival < byArrival.size() && procs[byArrival[nextArrival]].arrival <= cur) {
+            int i = byArrival[nextArrival++];
+            if (procs[i].remaining > 0) insert(i, key(i));
+        }
+    }
+    // A (possibly) new process takes the CPU: the preempted one goes back to the queue
+    template <class KeyFn> void dispatch(const vector<Process> &procs, int idx, KeyFn key) {
+        if (!out || idx == running) return;
+        if (running >= 0 && procs[running].remaining > 0) insert(running, key(running));
+        extract(idx);
+        running = idx;
+    }
+};
+
+// FCFS - Non-preemptive (time simulated)
+Timeline simulateFCFS(vector<Process> &procs) {
+    int cur = 0;
+    Timeline gantt;
+    // sort by arrival then pid
+    sort(procs.begin(), procs.end(), [](const Process &a, const Process &b){
+        if (a.arrival != b.arrival) return a.arrival < b.arrival;
+        return a.pid < b.pid;
+    });
+    RQTracer tr(procs);
+    for (auto &p : procs) {
+        if (cur < p.arrival) {
+            // CPU idle until arrival
+            while (cur < p.arrival) { gantt.push_back(0); cur++; }
+        }
+        tr.admit(procs, cur, [](int i){ return (long long)i; });
+        tr.extract((int)(&p - &procs[0]));
+        // start if first time
+        if (p.start == -1) p.start = cur, p.response = p.start - p.arrival;
+        // run to completion
+        for (int i = 0; i < p.burst; ++i) {
+            gantt.push_back(p.pid);
+            cur++;
+        }
+        p.completion = cur;
+    }
+    // start/completion are written back into procs; the caller computes metrics
+    return gantt;
+}
+
+Timeline FCFS(vector<Process> procs) {
+    cout << "=== FCFS (Non-preemptive) ===\n";
+    Timeline gantt = runPolicyQuiet(1, procs, 0);
+    computeAndPrintMetrics(procs, gantt);
+    printGantt(gantt);
+    return gantt;
+}
+
+// SRTF (Shortest Remaining Time First) - preemptive, 1-unit tick simulation
+Timeline simulateSRTF(vector<Process> &procs) {
+    int n = (int)procs.size();
+    Timeline gantt;
+    int completed = 0;
+    int cur = 0;
+    // Keep processes in original order but refer by index
+    resetProcesses(procs);
+    RQTracer tr(procs);
+    auto key = [&](int i){ return rqKey(procs[i].remaining, 0); };
+
+    while (completed < n) {
+        tr.admit(procs, cur, key);
+        // find index with minimum remaining among arrived
+        int idx = -1, minRem = INT_MAX;
+        for (int i = 0; i < n; ++i) {
+            if (procs[i].arrival <= cur && procs[i].remaining > 0) {
+                if (procs[i].remaining < minRem) {
+                    minRem = procs[i].remaining;
+                    idx = i;
+                }
+            }
+        }
+        if (idx == -1) {
+            // idle
+            gantt.push_back(0);
+            cur++;
+            continue;
+        }
+        tr.dispatch(procs, idx, key);
+        // if first time on CPU
+        if (procs[idx].start == -1) {
+            procs[idx].start = cur;
+            procs[idx].response = procs[idx].start - procs[idx].arrival;
+        }
+        // execute 1 unit
+        gantt.push_back(procs[idx].pid);
+        procs[idx].remaining -= 1;
+        cur++;
+        if (procs[idx].remaining == 0) {
+            procs[idx].completion = cur;
+            completed++;
+        }
+    }
+
+    return gantt;
+}
+
+Timeline SRTF(vector<Process> procs) {
+    cout << "=== SRTF (Preemptive SJF) ===\n";
+    Timeline gantt = runPolicyQuiet(2, procs, 0);
+    computeAndPrintMetrics(procs, gantt);
+    printGantt(gantt);
+    return gantt;
+}
+
+// Preemptive Priority Scheduling (lower number = higher priority)
+Timeline simulatePreemptivePriority(vector<Process> &procs) {
+    int n = (int)procs.size();
+    Timeline gantt;
+    int completed = 0;
+    int cur = 0;
+    resetProcesses(procs);
+    RQTracer tr(procs);
+    auto key = [&](int i){ return rqKey(procs[i].priority, procs[i].remaining); };
+
+    while (completed < n) {
+        tr.admit(procs, cur, key);
+        int idx = -1, bestPr = INT_MAX;
+        for (int i = 0; i < n; ++i) {
+            if (procs[i].arrival <= cur && procs[i].remaining > 0) {
+                if (procs[i].priority < bestPr) {
+                    bestPr = procs[i].priority;
+                    idx = i;
+                } else if (procs[i].priority == bestPr) {
+                    // tie-breaker: lower remaining burst or earlier arrival
+                    if (idx == -1 || procs[i].remaining < procs[idx].remaining) idx = i;
+                }
+            }
+        }
+        if (idx == -1) { gantt.push_back(0); cur++; continue; }
+        tr.dispatch(procs, idx, key);
+        if (procs[idx].start == -1) {
+            procs[idx].start = cur;
+            procs[idx].response = procs[idx].start - procs[idx].arrival;
+        }
+        // execute 1 unit
+        gantt.push_back(procs[idx].pid);
+        procs[idx].remaining -= 1;
+        cur++;
+        if (procs[idx].remaining == 0) {
+            procs[idx].completion = cur;
+            completed++;
+        }
+    }
+
+    return gantt;
+}
+
+Timeline PreemptivePriority(vector<Process> procs) {
+    cout << "=== Preemptive Priority Scheduling ===\n";
+    Timeline gantt = runPolicyQuiet(3, procs, 0);
+    computeAndPrintMetrics(procs, gantt);
+    printGantt(gantt);
+    return gantt;
+}
+
+// Round Robin scheduling (time quantum tq)
+Timeline simulateRoundRobin(vector<Process> &procs, int tq) {
+    int n = (int)procs.size();
+    Timeline gantt;
+    queue<int> q;
+    vector<bool> inQ(n, false);
+    int cur = 0, completed = 0;
+    resetProcesses(procs);
+    RQTracer tr(procs);
+    long long seq = 0; // FIFO order is an increasing sequence key
+
+    while (completed < n) {
+        // enqueue newly arrived processes
+        for (int i = 0; i < n; ++i) {
+            if (!inQ[i] && procs[i].arrival <= cur && procs[i].remaining > 0) {
+                q.push(i);
+                tr.insert(i, seq++);
+                inQ[i] = true;
+            }
+        }
+
+        if (q.empty()) {
+            // CPU idle
+            gantt.push_back(0);
+            cur++;
+            continue;
+        }
+
+        int idx = q.front(); q.pop();
+        tr.extract(idx);
+        // If first time scheduled
+        if (procs[idx].start == -1) {
+            procs[idx].start = cur;
+            procs[idx].response = procs[idx].start - procs[idx].arrival;
+        }
+        int exec = min(tq, procs[idx].remaining);
+        for (int i = 0; i < exec; ++i) {
+            gantt.push_back(procs[idx].pid);
+            procs[idx].remaining -= 1;
+            cur++;
+            // enqueue new arrivals that come while CPU is executing
+            for (int j = 0; j < n; ++j) {
+                if (!inQ[j] && procs[j].arrival <= cur && procs[j].remaining > 0) {
+                    q.push(j);
+                    tr.insert(j, seq++);
+                    inQ[j] = true;
+                }
+            }
+        }
+        if (procs[idx].remaining > 0) {
+            q.push(idx);
+            tr.insert(idx, seq++);
+        } else {
+            procs[idx].completion = cur;
+            completed++;
+        }
+    }
+
+    return gantt;
+}
+
+Timeline RoundRobin(vector<Process> procs, int tq) {
+    cout << "=== Round Robin (Quantum=" << tq << ") ===\n";
+    Timeline gantt = runPolicyQuiet(4, procs, tq);
+    computeAndPrintMetrics(procs, gantt);
+    printGantt(gantt);
+    return gantt;
+}
+
+Timeline EEVDF(vector<Process> procs, int slice) {
+    cout << "=== EEVDF (Slice=" << slice << ") ===\n";
+    Timeline gantt = runPolicyQuiet(5, procs, slice);
+    computeAndPrintMetrics(procs, gantt);
+    printGantt(gantt);
+    return gantt;
+}
+
+// ---------------------------------------------------------------------------
+// Ready-queue implementations
+// ---------------------------------------------------------------------------
+// All queues are indexed by process id (0..n-1) and order by (key, id).
+// Interface: reset(n), insert(id, key), extractMin(), decreaseKey(id, key),
+// remove(id), empty().
+
+template <int D>
+struct DaryHeapRQ {
+    vector<int> heap, pos;
+    vector<long long> key;
+
+    void reset(int n) { heap.clear(); pos.assign(n, -1); key.assign(n, 0); }
+    bool empty() const { return heap.empty(); }
+    bool less(int a, int b) const { return key[a] != key[b] ? key[a] < key[b] : a < b; }
+    void place(int i, int id) { heap[i] = id; pos[id] = i; }
+    void siftUp(int i) {
+        int id = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (!less(id, heap[parent])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, id);
+    }
+    void siftDown(int i) {
+        int id = heap[i], n = (int)heap.size();
+        while (true) {
+            int first = i * D + 1, best = -1;
+            for (int c = first; c < min(n, first + D); ++c)
+                if (best < 0 || less(heap[c], heap[best])) best = c;
+            if (best < 0 || !less(heap[best], id)) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, id);
+    }
+    void insert(int id, long long k) {
+        key[id] = k;
+        heap.push_back(id);
+        siftUp((int)heap.size() - 1);
+    }
+    int top() const { return heap[0]; }
+    int extractMin() {
+        int id = heap[0];
+        remove(id);
+        return id;
+    }
+    void decreaseKey(int id, long long k) { key[id] = k; siftUp(pos[id]); }
+    void remove(int id) {
+        int i = pos[id], last = heap.back();
+        heap.pop_back();
+        pos[id] = -1;
+        if (last == id) return;
+        place(i, last);
+        siftUp(i);
+        siftDown(pos[last]);
+    }
+};
+
+using BinaryHeapRQ = DaryHeapRQ<2>;
+
+struct PairingHeapRQ {
+    vector<long long> key;
+    vector<int> child, sib, prev;  // prev is the parent for a first child, else the left sibling
+    vector<int> scratch;
+    int root = -1;
+
+    void reset(int n) {
+        key.assign(n, 0); child.assign(n, -1); sib.assign(n, -1); prev.assign(n, -1);
+        root = -1;
+    }
+    bool empty() const { return root < 0; }
+    bool less(int a, int b) const { return key[a] != key[b] ? key[a] < key[b] : a < b; }
+    int meld(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (less(b, a)) swap(a, b);
+        sib[b] = child[a];
+        if (child[a] >= 0) prev[child[a]] = b;
+        prev[b] = a;
+        child[a] = b;
+        return a;
+    }
+    int mergePairs(int first) {
+        scratch.clear();
+        for (int c = first; c >= 0;) {
+            int next = sib[c];
+            sib[c] = prev[c] = -1;
+            scratch.push_back(c);
+            c = next;
+        }
+        if (scratch.empty()) return -1;
+        size_t m = 0;
+        for (size_t i = 0; i + 1 < scratch.size(); i += 2) scratch[m++] = meld(scratch[i], scratch[i + 1]);
+        if (scratch.size() % 2) scratch[m++] = scratch.back();
+        int r = scratch[m - 1];
+        for (size_t i = m - 1; i-- > 0;) r = meld(scratch[i], r);
+        return r;
+    }
+    void detach(int id) {
+        int p = prev[id];
+        if (child[p] == id) child[p] = sib[id];
+        else sib[p] = sib[id];
+        if (sib[id] >= 0) prev[sib[id]] = p;
+        sib[id] = prev[id] = -1;
+    }
+    void insert(int id, long long k) {
+        key[id] = k;
+        child[id] = sib[id] = prev[id] = -1;
+        root = meld(root, id);
+    }
+    int extractMin() {
+        int r = root;
+        root = mergePairs(child[r]);
+        child[r] = -1;
+        return r;
+    }
+    void decreaseKey(int id, long long k) {
+        key[id] = k;
+        if (id == root) return;
+        detach(id);
+        root = meld(root, id);
+    }
+    void remove(int id) {
+        if (id == root) { extractMin(); return; }
+        detach(id);
+        int sub = mergePairs(child[id]);
+        child[id] = -1;
+        root = meld(root, sub);
+    }
+};
+
+// Monotone integer queue: keys must never drop below the last extracted key.
+// Decrease-key and remove are lazy (stale bucket entries are skipped).
+struct RadixHeapRQ {
+    using U = unsigned long long;
+    vector<pair<U, int>> buckets[65];
+    vector<pair<U, int>> moved;
+    vector<U> key;
+    vector<char> live;
+    U last = 0;
+    size_t count = 0;
+
+    static U toUnsigned(long long k) { return (U)k ^ (1ULL << 63); }
+    static int bucketOf(U x, U last) { return x == last ? 0 : 64 - __builtin_clzll(x ^ last); }
+    void reset(int n) {
+        for (auto &b : buckets) b.clear();
+        key.assign(n, 0); live.assign(n, 0);
+        last = 0; count = 0;
+    }
+    bool empty() const { return count == 0; }
+    void push(int id) { buckets[bucketOf(key[id], last)].push_back({key[id], id}); }
+    void insert(int id, long long k) { key[id] = toUnsigned(k); live[id] = 1; count++; push(id); }
+    void decreaseKey(int id, long long k) { key[id] = toUnsigned(k); push(id); }
+    void remove(int id) { live[id] = 0; count--; }
+    int extractMin() {
+        while (true) {
+            // bucket 0 holds keys equal to `last`; ties go to the lowest id
+            auto &b0 = buckets[0];
+            int best = -1;
+            for (size_t j = 0; j < b0.size();) {
+                auto [k, id] = b0[j];
+                if (!live[id] || key[id] != k) { b0[j] = b0.back(); b0.pop_back(); continue; }
+                if (best < 0 || id < b0[best].second) best = (int)j;
+                ++j;
+            }
+            if (best >= 0) {
+                int id = b0[best].second;
+                b0[best] = b0.back(); b0.pop_back();
+                live[id] = 0; count--;
+                return id;
+            }
+            int i = 1;
+            while (buckets[i].empty()) ++i;
+            U lo = ~0ULL;
+            for (auto &e : buckets[i]) if (live[e.second] && key[e.second] == e.first) lo = min(lo, e.first);
+            if (lo == ~0ULL) { buckets[i].clear(); continue; }
+            last = lo;
+            moved.clear();
+            moved.swap(buckets[i]);
+            for (auto &e : moved)
+                if (live[e.second] && key[e.second] == e.first) buckets[bucketOf(e.first, last)].push_back(e);
+        }
+    }
+};
+
+struct SkipListRQ {
+    static const int MaxLevel = 20;
+    vector<long long> key;
+    vector<int> next;        // (n + 1) x MaxLevel links, row n is the head
+    vector<unsigned char> level;
+    int head = 0;
+    unsigned rng = 2463534242u;
+    int update[MaxLevel];
+
+    void reset(int n) {
+        key.assign(n, 0); level.assign(n, 0);
+        head = n;
+        next.assign((size_t)(n + 1) * MaxLevel, -1);
+    }
+    bool empty() const { return next[(size_t)head * MaxLevel] < 0; }
+    int &link(int node, int l) { return next[(size_t)node * MaxLevel + l]; }
+    bool less(int a, int b) const { return key[a] != key[b] ? key[a] < key[b] : a < b; }
+    int randomLevel() {
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        int l = 1;
+        unsigned r = rng;
+        while (l < MaxLevel && (r & 3) == 0) { l++; r >>= 2; }
+        return l;
+    }
+    void findPredecessors(int id) {
+        int x = head;
+        for (int l = MaxLevel - 1; l >= 0; --l) {
+            while (link(x, l) >= 0 && less(link(x, l), id)) x = link(x, l);
+            update[l] = x;
+        }
+    }
+    void insert(int id, long long k) {
+        key[id] = k;
+        findPredecessors(id);
+        level[id] = (unsigned char)randomLevel();
+        for (int l = 0; l < level[id]; ++l) {
+            link(id, l) = link(update[l], l);
+            link(update[l], l) = id;
+        }
+    }
+    int extractMin() {
+        int id = link(head, 0);
+        for (int l = 0; l < level[id]; ++l) link(head, l) = link(id, l);
+        return id;
+    }
+    void remove(int id) {
+        findPredecessors(id);
+        for (int l = 0; l < level[id]; ++l)
+            if (link(update[l], l) == id) link(update[l], l) = link(id, l);
+    }
+    void decreaseKey(int id, long long k) { remove(id); insert(id, k); }
+};
+
+struct RBTreeRQ {
+    set<pair<long long, int>> tree;
+    vector<long long> key;
+
+    void reset(int n) { tree.clear(); key.assign(n, 0); }
+    bool empty() const { return tree.empty(); }
+    void insert(int id, long long k) { key[id] = k; tree.insert({k, id}); }
+    int extractMin() {
+        int id = tree.begin()->second;
+        tree.erase(tree.begin());
+        return id;
+    }
+    void decreaseKey(int id, long long k) { tree.erase({key[id], id}); insert(id, k); }
+    void remove(int id) { tree.erase({key[id], id}); }
+};
+
+// FIFO for policies whose keys only ever grow (FCFS, Round Robin); keys are ignored
+struct FifoRQ {
+    deque<int> q;
+
+    void reset(int) { q.clear(); }
+    bool empty() const { return q.empty(); }
+    void insert(int id, long long) { q.push_back(id); }
+    int extractMin() {
+        int id = q.front();
+        q.pop_front();
+        return id;
+    }
+    void decreaseKey(int, long long) { throw logic_error("FifoRQ does not support decrease-key"); }
+    void remove(int id) { q.erase(find(q.begin(), q.end(), id)); }
+};
+
+// Unsorted array; the min scan over contiguous keys vectorizes, which beats
+// pointer-chasing structures when only a handful of processes are ready
+struct LinearScanRQ {
+    vector<long long> keys;
+    vector<int> ids, pos;
+
+    void reset(int n) { keys.clear(); ids.clear(); pos.assign(n, -1); }
+    bool empty() const { return keys.empty(); }
+    void insert(int id, long long k) {
+        pos[id] = (int)keys.size();
+        keys.push_back(k);
+        ids.push_back(id);
+    }
+    int minSlot() const {
+        long long best = LLONG_MAX;
+        for (long long k : keys) best = min(best, k);
+        int slot = -1;
+        for (int i = 0; i < (int)keys.size(); ++i)
+            if (keys[i] == best && (slot < 0 || ids[i] < ids[slot])) slot = i;
+        return slot;
+    }
+    void removeSlot(int i) {
+        pos[ids[i]] = -1;
+        keys[i] = keys.back(); ids[i] = ids.back();
+        keys.pop_back(); ids.pop_back();
+        if (i < (int)keys.size()) pos[ids[i]] = i;
+    }
+    int extractMin() {
+        int i = minSlot(), id = ids[i];
+        removeSlot(i);
+        return id;
+    }
+    void decreaseKey(int id, long long k) { keys[pos[id]] = k; }
+    void remove(int id) { removeSlot(pos[id]); }
+};
+
+// One lazy heap per priority level (the rqKey major part) plus a bitmap of
+// non-empty levels; extract-min finds the first level with a count-trailing-zeros
+struct BucketRQ {
+    long long base = 0;
+    vector<vector<pair<long long, int>>> bucket;
+    vector<uint64_t> bitmap;
+    vector<long long> key;
+    vector<char> live;
+    size_t count = 0;
+
+    void configure(long long minMajor, int levels) {
+        base = minMajor;
+        bucket.assign(levels, {});
+        bitmap.assign((levels + 63) / 64, 0);
+    }
+    void reset(int n) {
+        for (auto &b : bucket) b.clear();
+        fill(bitmap.begin(), bitmap.end(), 0);
+        key.assign(n, 0); live.assign(n, 0);
+        count = 0;
+    }
+    bool empty() const { return count == 0; }
+    int levelOf(long long k) const { return (int)((k >> rqMinorBits) - base); }
+    void push(int id) {
+        int l = levelOf(key[id]);
+        bucket[l].push_back({key[id], id});
+        push_heap(bucket[l].begin(), bucket[l].end(), greater<pair<long long, int>>());
+        bitmap[l >> 6] |= 1ULL << (l & 63);
+    }
+    void insert(int id, long long k) { key[id] = k; live[id] = 1; count++; push(id); }
+    void decreaseKey(int id, long long k) { key[id] = k; push(id); }
+    void remove(int id) { live[id] = 0; count--; }
+    int extractMin() {
+        for (size_t w = 0;; ++w) {
+            while (bitmap[w]) {
+                int l = (int)(w * 64 + __builtin_ctzll(bitmap[w]));
+                auto &b = bucket[l];
+                while (!b.empty()) {
+                    auto [k, id] = b.front();
+                    pop_heap(b.begin(), b.end(), greater<pair<long long, int>>());
+                    b.pop_back();
+                    if (!live[id] || key[id] != k) continue;
+                    live[id] = 0; count--;
+                    if (b.empty()) bitmap[w] &= ~(1ULL << (l & 63));
+                    return id;
+                }
+                bitmap[w] &= ~(1ULL << (l & 63));
+            }
+        }
+    }
+};
+
+// Fixed-capacity ready queue for at most N processes (ids below N) that never
+// allocates: std::array storage, a ring buffer for the FIFO policies, and for
+// the others a ready bitmask walked with count-trailing-zeros. With fewer than
+// 64 values of the rqKey major part (priorities, or SRTF remaining times) each
+// level has its own bitmask and a mask of non-empty levels picks the level with
+// one count-trailing-zeros. In Exact mode the keys of a level are equal and
+// ties go to the lowest index, so the lowest set bit of the level is the minimum.
+template <int N>
+class BitsetRQ {
+public:
+    enum class Mode { Scan, Fifo, Levels, Exact };
+
+    void configure(Mode mode, long long minMajor = 0) { mode_ = mode; base_ = minMajor; }
+    void reset(int n) {
+        if (n > N) throw logic_error("BitsetRQ capacity exceeded");
+        for (auto &l : levels_) l.fill(0);
+        levelCount_.fill(0);
+        levelMask_ = 0;
+        head_ = count_ = 0;
+    }
+    bool empty() const { return count_ == 0; }
+    void insert(int id, long long k) {
+        key_[id] = k;
+        if (mode_ == Mode::Fifo) ring_[(head_ + count_) % N] = id;
+        else set(id);
+        count_++;
+    }
+    int extractMin() {
+        count_--;
+        if (mode_ == Mode::Fifo) {
+            int id = ring_[head_];
+            head_ = (head_ + 1) % N;
+            return id;
+        }
+        int l = levelMask_ ? __builtin_ctzll(levelMask_) : 0;
+        const auto &mask = levels_[l];
+        int best = -1;
+        if (mode_ == Mode::Exact) {
+            int w = 0;
+            while (!mask[w]) ++w;
+            best = w * 64 + __builtin_ctzll(mask[w]);
+            clear(best);
+            return best;
+        }
+        for (int w = 0; w < Words; ++w)
+            for (uint64_t bits = mask[w]; bits; bits &= bits - 1) {
+                int id = w * 64 + __builtin_ctzll(bits);
+                if (best < 0 || key_[id] < key_[best]) best = id;
+                if (levelCount_[l] == 1) break;
+            }
+        clear(best);
+        return best;
+    }
+    void decreaseKey(int id, long long k) {
+        if (mode_ == Mode::Fifo) throw logic_error("BitsetRQ FIFO mode does not support decrease-key");
+        clear(id);
+        key_[id] = k;
+        set(id);
+    }
+    void remove(int id) {
+        count_--;
+        if (mode_ != Mode::Fifo) { clear(id); return; }
+        int i = 0;
+        while (ring_[(head_ + i) % N] != id) ++i;
+        for (; i < count_; ++i) ring_[(head_ + i) % N] = ring_[(head_ + i + 1) % N];
+    }
+
+private:
+    static constexpr int Words = N / 64;
+    int levelOf(int id) const { return mode_ >= Mode::Levels ? (int)((key_[id] >> rqMinorBits) - base_) : 0; }
+    void set(int id) {
+        int l = levelOf(id);
+        levels_[l][id >> 6] |= 1ULL << (id & 63);
+        levelCount_[l]++;
+        levelMask_ |= 1ULL << l;
+    }
+    void clear(int id) {
+        int l = levelOf(id);
+        levels_[l][id >> 6] &= ~(1ULL << (id & 63));
+        if (--levelCount_[l] == 0) levelMask_ &= ~(1ULL << l);
+    }
+
+    Mode mode_ = Mode::Scan;
+    long long base_ = 0;
+    array<long long, N> key_;
+    array<int, N> ring_;
+    array<array<uint64_t, Words>, 64> levels_;
+    array<int, 64> levelCount_;
+    uint64_t levelMask_ = 0;
+    int head_ = 0, count_ = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Event-driven engine
+// ---------------------------------------------------------------------------
+// Jumps from event to event (arrival, completion, quantum expiry) instead of
+// ticking every time unit, and keeps the ready set in a pluggable ready queue.
+// Selection keys and tie-breaks match the tick simulators, so the resulting
+// timelines are identical.
+
+struct Slice {
+    int pid;
+    int start;
+    int end;
+};
+
+// Slices in time order. A compact run (see runEventEngine) records skipped
+// round-robin rounds as one slice and keeps the count of the others here.
+struct Schedule : vector<Slice> {
+    long long compactedSlices = 0;
+};
+
+Timeline toTimeline(const Schedule &schedule) {
+    if (schedule.compactedSlices > 0) throw logic_error("Compact schedules cannot be expanded to a timeline");
+    Timeline g;
+    for (auto &s : schedule) {
+        if ((int)g.size() < s.start) g.resize(s.start, 0);
+        g.insert(g.end(), s.end - s.start, s.pid);
+    }
+    return g;
+}
+
+// Scratch buffers of one engine run, kept by callers that run the engine in a
+// loop so repeated runs do not allocate once the buffers have grown
+struct EngineWorkspace {
+    vector<int> byArrival, order, fenwick, byRound;
+    vector<char> finished;
+    vector<long long> sortedRem, prefix;
+};
+
+// With `compact`, round-robin rounds skipped by the fast path are recorded as one
+// slice plus a count instead of one slice per quantum; enough for the metrics.
+template <class RQ>
+void runEventEngine(vector<Process> &procs, int choice, int tq, RQ &rq, EngineWorkspace &ws, Schedule &out,
+                    bool compact = false) {
+    if (choice == 1) {
+        // FCFS reports in arrival order, like the tick simulator
+        sort(procs.begin(), procs.end(), [](const Process &a, const Process &b){
+            if (a.arrival != b.arrival) return a.arrival < b.arrival;
+            return a.pid < b.pid;
+        });
+    }
+    resetProcesses(procs);
+    int n = (int)procs.size();
+    rq.reset(n);
+    vector<int> &byArrival = ws.byArrival;
+    byArrival.resize(n);
+    iota(byArrival.begin(), byArrival.end(), 0);
+    // index as tie-break: the stable order without stable_sort's temporary buffer
+    sort(byArrival.begin(), byArrival.end(), [&](int a, int b){
+        return procs[a].arrival != procs[b].arrival ? procs[a].arrival < procs[b].arrival : a < b;
+    });
+
+    bool preemptive = (choice == 2 || choice == 3);
+    long long seq = 0;
+    auto key = [&](int i, int boost = 0) {
+        return choice == 2 ? rqKey(procs[i].remaining - boost, 0)
+                           : rqKey(procs[i].priority - boost, procs[i].remaining);
+    };
+    size_t queued = 0;
+    auto enqueue = [&](int i) { rq.insert(i, preemptive ? key(i) : seq++); queued++; };
+    size_t next = 0;
+    auto admit = [&](int t) {
+        while (next < byArrival.size() && procs[byArrival[next]].arrival <= t) enqueue(byArrival[next++]);
+    };
+    out.clear();
+    out.compactedSlices = 0;
+    auto emit = [&](int pid, int s, int e) {
+        if (e <= s) return;
+        if (!out.empty() && out.back().pid == pid && out.back().end == s) out.back().end = e;
+        else out.push_back({pid, s, e});
+    };
+    // Queueing ends at the first dispatch; a switch to a different process than the
+    // last one on the CPU costs contextSwitchCost before it runs. The preempted share
+    // is the rest of the waiting time, settled once at completion.
+    int lastOnCPU = -1;
+    auto dispatch = [&](int i, int &now) {
+        Process &p = procs[i];
+        if (p.start == -1) p.queueing = now - p.arrival;
+        if (contextSwitchCost > 0 && lastOnCPU >= 0 && lastOnCPU != i) {
+            emit(-1, now, now + contextSwitchCost);
+            p.switchOverhead += contextSwitchCost;
+            now += contextSwitchCost;
+        }
+        lastOnCPU = i;
+        if (p.start == -1) p.start = now, p.response = now - p.arrival;
+    };
+
+    // Round-robin fast path (compact runs). With no arrival due before the end of a
+    // round, full rounds over the k ready processes are settled analytically:
+    // process i ends in round ceil(r_i / tq), the rounds up to m take
+    // D(m) = sum min(r_i, m*tq), and full rounds keep the queue order, so the
+    // survivors are re-queued unchanged. Costs O(k log k) per skip.
+    int completed = 0;
+    vector<int> &order = ws.order, &fenwick = ws.fenwick, &byRound = ws.byRound;
+    vector<char> &finished = ws.finished;
+    vector<long long> &sortedRem = ws.sortedRem, &prefix = ws.prefix;
+    auto skipRounds = [&](int &now) {
+        int arrival = next < byArrival.size() ? procs[byArrival[next]].arrival : INT_MAX;
+        if (choice != 4 || !compact || contextSwitchCost > 0 || queued == 0) return false;
+        if (arrival != INT_MAX && (long long)arrival - now <= 4LL * (long long)queued * tq) return false;
+        order.clear();
+        while (!rq.empty()) order.push_back(rq.extractMin());
+        queued = 0;
+        int k = (int)order.size();
+        sortedRem.resize(k);
+        for (int j = 0; j < k; ++j) sortedRem[j] = procs[order[j]].remaining;
+        sort(sortedRem.begin(), sortedRem.end());
+        prefix.assign(k + 1, 0);
+        for (int j = 0; j < k; ++j) prefix[j + 1] = prefix[j] + sortedRem[j];
+        auto elapsed = [&](long long m) {  // D(m)
+            long long cap = m * tq;
+            long long c = upper_bound(sortedRem.begin(), sortedRem.end(), cap) - sortedRem.begin();
+            return prefix[c] + (k - c) * cap;
+        };
+        auto roundsOf = [&](int i) { return ((long long)procs[i].remaining + tq - 1) / tq; };
+        long long rounds = (sortedRem.back() + tq - 1) / tq;
+        if (arrival != INT_MAX) {
+            long long lo = 1, hi = rounds;  // the guard above makes round 1 fit
+            while (lo < hi) {
+                long long mid = (lo + hi + 1) / 2;
+                if (now + elapsed(mid) < arrival) lo = mid;
+                else hi = mid - 1;
+            }
+            rounds = lo;
+        }
+
+        // first dispatches all happen in round 1
+        long long t = now;
+        for (int i : order) {
+            Process &p = procs[i];
+            if (p.start == -1) p.queueing = (int)t - p.arrival, p.start = (int)t, p.response = p.start - p.arrival;
+            t += min<long long>(tq, p.remaining);
+        }
+
+        // Completions, grouped by finishing round c. Within round c a finisher waits
+        // for the earlier processes still alive: a full quantum from those that
+        // finish later (counted with a Fenwick tree over queue positions) and the
+        // last piece from earlier finishers of the same round.
+        byRound.resize(k);
+        iota(byRound.begin(), byRound.end(), 0);
+        stable_sort(byRound.begin(), byRound.end(), [&](int a, int b){ return roundsOf(order[a]) < roundsOf(order[b]); });
+        fenwick.assign(k + 1, 0);
+        for (int j = 1; j <= k; ++j) { fenwick[j]++; if (j + (j & -j) <= k) fenwick[j + (j & -j)] += fenwick[j]; }
+        auto fenwickAdd = [&](int pos, int v) { for (++pos; pos <= k; pos += pos & -pos) fenwick[pos] += v; };
+        auto fenwickBefore = [&](int pos) { int sum = 0; for (; pos > 0; pos -= pos & -pos) sum += fenwick[pos]; return sum; };
+
+        // Slice count for the compact record, walking the intervals of rounds over
+        // which the alive set (queue positions [firstAlive, lastAlive]) is constant
+        finished.assign(k, 0);
+        int firstAlive = 0, lastAlive = k - 1;
+        long long slices = 0, doneRounds = 0;
+        int lastPid = (!out.empty() && out.back().end == now && out.back().pid > 0) ? out.back().pid : INT_MIN;
+        size_t g = 0;
+        while (doneRounds < rounds) {
+            long long c = roundsOf(order[byRound[g]]);
+            long long upto = min(c, rounds);
+            while (finished[firstAlive]) firstAlive++;
+            while (finished[lastAlive]) lastAlive--;
+            long long alive = k - (long long)g;
+            int first = procs[order[firstAlive]].pid;
+            if (alive >= 2) slices += (upto - doneRounds) * alive - (first == lastPid);
+            else slices += first != lastPid;
+            lastPid = procs[order[lastAlive]].pid;
+            lastOnCPU = order[lastAlive];
+            doneRounds = upto;
+            if (c > rounds) break;
+            size_t groupEnd = g;
+            while (groupEnd < (size_t)k && roundsOf(order[byRound[groupEnd]]) == c) fenwickAdd(byRound[groupEnd++], -1);
+            long long roundStart = now + elapsed(c - 1), partial = 0;
+            for (; g < groupEnd; ++g) {
+                int pos = byRound[g];
+                Process &p = procs[order[pos]];
+                long long own = p.remaining - (c - 1) * tq;
+                p.completion = (int)(roundStart + (long long)tq * fenwickBefore(pos) + partial + own);
+                partial += own;
+                p.remaining = 0;
+                p.preempted = p.completion - p.arrival - p.burst - p.queueing - p.switchOverhead;
+                completed++;
+                finished[pos] = 1;
+            }
+        }
+
+        int end = (int)(now + elapsed(rounds));
+        if (slices == 0) out.back().end = end;
+        else out.push_back({lastPid, now, end}), out.compactedSlices += slices - 1;
+        now = end;
+        for (int i : order) {
+            if (procs[i].remaining == 0) continue;
+            procs[i].remaining -= (int)(rounds * tq);
+            enqueue(i);
+        }
+        return true;
+    };
+
+    // A preemption blocked by the minimum-granularity guard is deferred to a timer
+    // at sliceStart + minGranularity instead of being re-checked every time unit.
+    int now = 0, running = -1, sliceStart = 0, preemptTimer = INT_MAX;
+    while (completed < n) {
+        admit(now);
+        if (running < 0) {
+            if (rq.empty()) { now = max(now, procs[byArrival[next]].arrival); continue; }
+            if (compact && skipRounds(now)) continue;
+            running = rq.extractMin();
+            queued--;
+            dispatch(running, now);
+            sliceStart = now;
+            preemptTimer = INT_MAX;
+        }
+        Process &p = procs[running];
+        int end = now + (choice == 4 ? min(tq, p.remaining) : p.remaining);
+        if (preemptive && next < byArrival.size()) end = max(now, min(end, procs[byArrival[next]].arrival));
+        if (preemptTimer < end) end = max(now, preemptTimer);
+        p.remaining -= end - now;
+        now = end;
+        if (p.remaining == 0) {
+            p.completion = now;
+            p.preempted = now - p.arrival - p.burst - p.queueing - p.switchOverhead;
+            completed++;
+            emit(p.pid, sliceStart, now);
+            running = -1;
+            continue;
+        }
+        admit(now);
+        if (choice == 4) {
+            // arrivals during the slice queue ahead of the preempted process
+            emit(p.pid, sliceStart, now);
+            enqueue(running);
+            running = -1;
+        } else if (preemptive && !rq.empty()) {
+            if (minGranularity > 0 && now - sliceStart < minGranularity) {
+                preemptTimer = sliceStart + minGranularity;
+                continue;
+            }
+            preemptTimer = INT_MAX;
+            int best;
+            if (preemptThreshold == 0) {
+                // put the running process back and let the queue decide
+                rq.insert(running, key(running));
+                best = rq.extractMin();
+            } else {
+                // the challenger must beat the running key lowered by the threshold
+                best = rq.extractMin();
+                if (make_pair(key(best), best) < make_pair(key(running, preemptThreshold), running))
+                    rq.insert(running, key(running));
+                else { rq.insert(best, key(best)); best = running; }
+            }
+            if (best != running) {
+                emit(p.pid, sliceStart, now);
+                running = best;
+                dispatch(running, now);
+                sliceStart = now;
+            }
+        }
+    }
+}
+
+template <class RQ>
+Schedule runEventEngine(vector<Process> &procs, int choice, int tq, RQ &rq, bool compact = false) {
+    EngineWorkspace ws;
+    Schedule out;
+    runEventEngine(procs, choice, tq, rq, ws, out, compact);
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Adaptive engine selection
+// ---------------------------------------------------------------------------
+
+enum class EngineKind { Auto, Tick, Fifo, Linear, Bucket, BinaryHeap, DaryHeap, Pairing, SkipList, RBTree, Bitset };
+
+const vector<pair<string, EngineKind>> engineNames = {
+    {"auto", EngineKind::Auto}, {"tick", EngineKind::Tick}, {"fifo", EngineKind::Fifo},
+    {"linear", EngineKind::Linear}, {"bucket", EngineKind::Bucket}, {"binary", EngineKind::BinaryHeap},
+    {"dary", EngineKind::DaryHeap}, {"pairing", EngineKind::Pairing}, {"skiplist", EngineKind::SkipList},
+    {"rbtree", EngineKind::RBTree}, {"bitset", EngineKind::Bitset},
+};
+
+EngineKind engineOverride = EngineKind::Auto; // set with --engine=<name>
+
+string engineName(EngineKind k) {
+    for (auto &e : engineNames) if (e.second == k) return e.first;
+    return "?";
+}
+
+struct WorkloadShape {
+    int n = 0;
+    long long minPriority = 0, maxPriority = 0;
+    int minBurst = 0, maxBurst = 0;
+    int peakConcurrency = 0;   // most processes in the system at once (FCFS order)
+};
+
+WorkloadShape inspectWorkload(const vector<Process> &procs) {
+    WorkloadShape w;
+    w.n = (int)procs.size();
+    if (procs.empty()) return w;
+    w.minPriority = w.maxPriority = procs[0].priority;
+    w.minBurst = w.maxBurst = procs[0].burst;
+    vector<pair<int, int>> byArrival;
+    for (auto &p : procs) {
+        w.minPriority = min<long long>(w.minPriority, p.priority);
+        w.maxPriority = max<long long>(w.maxPriority, p.priority);
+        w.minBurst = min(w.minBurst, p.burst);
+        w.maxBurst = max(w.maxBurst, p.burst);
+        byArrival.push_back({p.arrival, p.burst});
+    }
+    sort(byArrival.begin(), byArrival.end());
+    // the number in system is policy independent within a busy period; FCFS gives a cheap estimate
+    priority_queue<long long, vector<long long>, greater<long long>> departures;
+    long long t = 0;
+    for (auto &[arrival, burst] : byArrival) {
+        while (!departures.empty() && departures.top() <= arrival) departures.pop();
+        t = max<long long>(t, arrival) + burst;
+        departures.push(t);
+        w.peakConcurrency = max(w.peakConcurrency, (int)departures.size());
+    }
+    return w;
+}
+
+bool engineSupports(EngineKind k, int choice, const WorkloadShape &w) {
+    if (k == EngineKind::Auto) return false;
+    if (k == EngineKind::Fifo) return choice == 1 || choice == 4;
+    if (k == EngineKind::Bucket) return choice == 3 && w.maxPriority - w.minPriority < 65536;
+    if (k == EngineKind::Bitset) return w.n <= 512;
+    return true;
+}
+
+// The pick among the growable ready queues, for any number of processes
+EngineKind chooseGeneralEngine(int choice, const WorkloadShape &w) {
+    if (choice == 1 || choice == 4) return EngineKind::Fifo;
+    if (w.peakConcurrency <= 32) return EngineKind::Linear;
+    if (choice == 3 && w.maxPriority - w.minPriority < 256) return EngineKind::Bucket;
+    // the engine re-inserts the running process at every arrival; pairing heaps make that O(1)
+    return EngineKind::Pairing;
+}
+
+// Small runs use the fixed-capacity bitset queue, which never allocates. It holds
+// up to 512 processes, but past 128 the rest of the engine dominates and the
+// growable queues are as fast (analysis 18).
+EngineKind chooseEngine(int choice, const WorkloadShape &w) {
+    return w.n <= 128 ? EngineKind::Bitset : chooseGeneralEngine(choice, w);
+}
+
+Timeline runTickSimulator(int choice, vector<Process> &procs, int tq) {
+    resetProcesses(procs);
+    switch (choice) {
+        case 1: return simulateFCFS(procs);
+        case 2: return simulateSRTF(procs);
+        case 3: return simulatePreemptivePriority(procs);
+        case 4: return simulateRoundRobin(procs, tq);
+    }
+    throw runtime_error("Unknown policy choice: " + to_string(choice));
+}
+
+// Bitset queue with the smallest capacity variant that holds n processes. The
+// scratch buffers are kept per thread and the schedule is sized up front, so a
+// run allocates only its result.
+template <int N>
+Schedule runBitsetEngine(int choice, vector<Process> &procs, int tq, const WorkloadShape &w, bool compact) {
+    using RQ = BitsetRQ<N>;
+    RQ q;
+    if (choice == 1 || choice == 4) q.configure(RQ::Mode::Fifo);
+    else if (choice == 2 && w.maxBurst < 64) q.configure(RQ::Mode::Exact, 0);
+    else if (choice == 3 && w.maxPriority - w.minPriority < 64) q.configure(RQ::Mode::Levels, w.minPriority);
+    static thread_local EngineWorkspace ws;
+    Schedule out;
+    long long slices = 2LL * w.n + 1;
+    if (choice == 4 && !compact) {
+        slices = 1;
+        for (auto &p : procs) slices += (p.burst + tq - 1) / tq;
+    }
+    out.reserve((size_t)min(slices, 1LL << 16));
+    runEventEngine(procs, choice, tq, q, ws, out, compact);
+    return out;
+}
+
+Schedule runEngineKind(EngineKind k, int choice, vector<Process> &procs, int tq, const WorkloadShape &w,
+                       bool compact = false) {
+    switch (k) {
+        case EngineKind::Bitset:
+            if (w.n <= 64) return runBitsetEngine<64>(choice, procs, tq, w, compact);
+            if (w.n <= 128) return runBitsetEngine<128>(choice, procs, tq, w, compact);
+            if (w.n <= 256) return runBitsetEngine<256>(choice, procs, tq, w, compact);
+            return runBitsetEngine<512>(choice, procs, tq, w, compact);
+        case EngineKind::Fifo: { FifoRQ q; return runEventEngine(procs, choice, tq, q, compact); }
+        case EngineKind::Linear: { LinearScanRQ q; return runEventEngine(procs, choice, tq, q, compact); }
+        case EngineKind::Bucket: {
+            BucketRQ q;
+            q.configure(w.minPriority, (int)(w.maxPriority - w.minPriority + 1));
+            return runEventEngine(procs, choice, tq, q, compact);
+        }
+        case EngineKind::BinaryHeap: { BinaryHeapRQ q; return runEventEngine(procs, choice, tq, q, compact); }
+        case EngineKind::Pairing: { PairingHeapRQ q; return runEventEngine(procs, choice, tq, q, compact); }
+        case EngineKind::SkipList: { SkipListRQ q; return runEventEngine(procs, choice, tq, q, compact); }
+        case EngineKind::RBTree: { RBTreeRQ q; return runEventEngine(procs, choice, tq, q, compact); }
+        default: { DaryHeapRQ<4> q; return runEventEngine(procs, choice, tq, q, compact); }
+    }
+}
+
+Schedule fromTimeline(const Timeline &g) {
+    Schedule out;
+    for (int t = 0; t < (int)g.size(); ++t) {
+        if (g[t] == 0) continue;
+        if (!out.empty() && out.back().pid == g[t] && out.back().end == t) out.back().end = t + 1;
+        else out.push_back({g[t], t, t + 1});
+    }
+    return out;
+}
+
+// Every process slice but the last ends by switching to another process or to idle
+int countContextSwitches(const Schedule &s) {
+    long long slices = s.compactedSlices;
+    for (auto &sl : s) if (sl.pid > 0) slices++;
+    return (int)min<long long>(INT_MAX, max(0LL, slices - 1));
+}
+
+Metrics computeMetrics(vector<Process> &procs, const Schedule &s) {
+    return computeMetrics(procs, s.empty() ? 0 : s.back().end, countContextSwitches(s));
+}
+
+// ---------------------------------------------------------------------------
+// EEVDF (earliest eligible virtual deadline first)
+// ---------------------------------------------------------------------------
+// As in Linux 6.6+: an entity's vruntime v grows by its service scaled by
+// NICE_0 / weight, and each request of `slice` time units gets the virtual
+// deadline vd = v + slice * NICE_0 / weight. The queue's virtual time V is the
+// weight-averaged vruntime; an entity is eligible when v <= V (its lag
+// w * (V - v) is non-negative). The scheduler runs the eligible entity with the
+// earliest deadline and re-decides at every arrival, request end and exit.
+// Arrivals join with zero lag (v = V). Weights follow the kernel's nice table,
+// with nice = priority - best priority (capped at 19).
+
+const long long EEVDFScale = 1 << 20;  // vruntime units per time unit at NICE_0 weight
+const int niceWeights[20] = {1024, 820, 655, 526, 423, 335, 272, 215, 172, 137,
+                             110, 87, 70, 56, 45, 36, 29, 23, 18, 15};
+
+int niceWeight(int priority, int minPriority) {
+    return niceWeights[min(19, max(0, priority - minPriority))];
+}
+
+// Treap of runnable entities ordered by (vruntime, id). Each node also keeps the
+// entity with the earliest deadline in its subtree, so the eligible entity with
+// the earliest deadline is found on one root-to-leaf path: an eligible node
+// makes its whole left subtree eligible too.
+class EligibilityTree {
+public:
+    void reset(int n) {
+        v_.assign(n, 0); vd_.assign(n, 0);
+        left_.assign(n, -1); right_.assign(n, -1); best_.assign(n, -1); prio_.resize(n);
+        mt19937 rng(n);
+        for (auto &p : prio_) p = rng();
+        root_ = -1;
+    }
+    bool empty() const { return root_ < 0; }
+    long long vruntime(int id) const { return v_[id]; }
+    long long deadline(int id) const { return vd_[id]; }
+
+    void insert(int id, long long v, long long vd) {
+        v_[id] = v; vd_[id] = vd;
+        // descend past higher-priority nodes, then split the rest under the new node
+        int *link = &root_;
+        path_.clear();
+        while (*link >= 0 && prio_[*link] > prio_[id]) {
+            path_.push_back(*link);
+            link = before(id, *link) ? &left_[*link] : &right_[*link];
+        }
+        split(*link, id, left_[id], right_[id]);
+        pull(id);
+        *link = id;
+        for (size_t k = path_.size(); k-- > 0;) pull(path_[k]);
+    }
+    void erase(int id) {
+        int *link = &root_;
+        path_.clear();
+        while (*link != id) {
+            path_.push_back(*link);
+            link = before(id, *link) ? &left_[*link] : &right_[*link];
+        }
+        *link = merge(left_[id], right_[id]);
+        for (size_t k = path_.size(); k-- > 0;) pull(path_[k]);
+    }
+    // Earliest deadline among entities with v * totalWeight <= weightedSum (v <= V exactly)
+    int pickEligible(__int128 weightedSum, long long totalWeight) const {
+        int node = root_, pick = -1;
+        while (node >= 0) {
+            if ((__int128)v_[node] * totalWeight <= weightedSum) {
+                pick = earlier(pick, node);
+                if (left_[node] >= 0) pick = earlier(pick, best_[left_[node]]);
+                node = right_[node];
+            } else {
+                node = left_[node];
+            }
+        }
+        return pick;
+    }
+
+private:
+    bool before(int a, int b) const { return v_[a] != v_[b] ? v_[a] < v_[b] : a < b; }
+    int earlier(int a, int b) const {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        return (vd_[b] < vd_[a] || (vd_[b] == vd_[a] && b < a)) ? b : a;
+    }
+    void pull(int x) {
+        best_[x] = x;
+        if (left_[x] >= 0) best_[x] = earlier(best_[x], best_[left_[x]]);
+        if (right_[x] >= 0) best_[x] = earlier(best_[x], best_[right_[x]]);
+    }
+    // l gets the nodes ordered before id, r the rest
+    void split(int t, int id, int &l, int &r) {
+        if (t < 0) { l = r = -1; return; }
+        if (before(t, id)) {
+            split(right_[t], id, right_[t], r);
+            l = t;
+        } else {
+            split(left_[t], id, l, left_[t]);
+            r = t;
+        }
+        pull(t);
+    }
+    int merge(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (prio_[a] > prio_[b]) { right_[a] = merge(right_[a], b); pull(a); return a; }
+        left_[b] = merge(a, left_[b]);
+        pull(b);
+        return b;
+    }
+
+    vector<long long> v_, vd_;
+    vector<int> left_, right_, best_;
+    vector<uint32_t> prio_;
+    vector<int> path_;
+    int root_ = -1;
+};
+
+struct EEVDFStats {
+    double maxLag = 0, minLag = 0;  // lag of the picked entity, in time units
+};
+
+Schedule simulateEEVDF(vector<Process> &procs, int slice, EEVDFStats *stats = nullptr) {
+    resetProcesses(procs);
+    int n = (int)procs.size();
+    vector<int> byArrival(n), weight(n);
+    iota(byArrival.begin(), byArrival.end(), 0);
+    stable_sort(byArrival.begin(), byArrival.end(), [&](int a, int b){ return procs[a].arrival < procs[b].arrival; });
+    int minPriority = INT_MAX;
+    for (auto &p : procs) minPriority = min(minPriority, p.priority);
+    for (int i = 0; i < n; ++i) weight[i] = niceWeight(procs[i].priority, minPriority);
+
+    EligibilityTree tree;
+    tree.reset(n);
+    __int128 weightedSum = 0;  // sum of w * v over runnable entities
+    long long totalWeight = 0, lastV = 0;
+    auto virtualTime = [&] { return totalWeight ? (long long)(weightedSum / totalWeight) : lastV; };
+    auto request = [&](int i, long long v) { return v + (long long)slice * EEVDFScale / weight[i]; };
+    size_t next = 0;
+    auto admit = [&](int t) {
+        while (next < byArrival.size() && procs[byArrival[next]].arrival <= t) {
+            int i = byArrival[next++];
+            long long v = virtualTime();
+            tree.insert(i, v, request(i, v));
+            weightedSum += (__int128)weight[i] * v;
+            totalWeight += weight[i];
+        }
+    };
+
+    Schedule out;
+    auto emit = [&](int pid, int s, int e) {
+        if (e <= s) return;
+        if (!out.empty() && out.back().pid == pid && out.back().end == s) out.back().end = e;
+        else out.push_back({pid, s, e});
+    };
+    // a pick of a different process than the last one on the CPU pays
+    // contextSwitchCost first, as in the event engine
+    int now = 0, completed = 0, lastOnCPU = -1;
+    while (completed < n) {
+        admit(now);
+        if (tree.empty()) { now = max(now, procs[byArrival[next]].arrival); continue; }
+        long long V = virtualTime();
+        int i = tree.pickEligible(weightedSum, totalWeight);
+        Process &p = procs[i];
+        long long v = tree.vruntime(i), vd = tree.deadline(i);
+        if (stats) {
+            double lag = (double)(V - v) * weight[i] / EEVDFScale;
+            stats->maxLag = max(stats->maxLag, lag);
+            stats->minLag = min(stats->minLag, lag);
+        }
+        if (p.start == -1) p.queueing = now - p.arrival;
+        if (contextSwitchCost > 0 && lastOnCPU >= 0 && lastOnCPU != i) {
+            emit(-1, now, now + contextSwitchCost);
+            p.switchOverhead += contextSwitchCost;
+            now += contextSwitchCost;
+        }
+        lastOnCPU = i;
+        if (p.start == -1) p.start = now, p.response = now - p.arrival;
+        // run to the end of the request, the end of the job or the next arrival
+        // (nothing if it arrived during the switch; the pick is then redone)
+        long long requestLeft = max(1LL, ((vd - v) * weight[i] + EEVDFScale - 1) / EEVDFScale);
+        long long run = min<long long>(p.remaining, requestLeft);
+        if (next < byArrival.size()) run = max(0LL, min<long long>(run, procs[byArrival[next]].arrival - now));
+        tree.erase(i);
+        weightedSum -= (__int128)weight[i] * v;
+        v += run * EEVDFScale / weight[i];
+        p.remaining -= (int)run;
+        emit(p.pid, now, now + (int)run);
+        now += (int)run;
+        if (p.remaining == 0) {
+            p.completion = now;
+            p.preempted = now - p.arrival - p.burst - p.queueing - p.switchOverhead;
+            totalWeight -= weight[i];
+            lastV = V;
+            completed++;
+            continue;
+        }
+        if (v >= vd) vd = request(i, v);
+        tree.insert(i, v, vd);
+        weightedSum += (__int128)weight[i] * v;
+    }
+    return out;
+}
+
+// Run one of the menu algorithms (1=FCFS, 2=SRTF, 3=Priority, 4=RR, 5=EEVDF with slice tq) without printing.
+// Uses the --engine override when it applies to the policy, otherwise the chooser.
+// Ready-queue tracing is implemented by the tick simulators, so it forces them.
+// `compact` allows counted slices (see runEventEngine) for callers that only need metrics.
+Schedule runPolicySchedule(int choice, vector<Process> &procs, int tq, bool compact = false) {
+    if (choice < 1 || choice > 5) throw runtime_error("Unknown policy choice: " + to_string(choice));
+    if (choice == 5) return simulateEEVDF(procs, tq);
+    // the tick simulators do not model the tuning knobs, so any of them forces the event engine
+    bool tick = rqTrace || (engineOverride == EngineKind::Tick && !engineTuned());
+    if (tick) return fromTimeline(runTickSimulator(choice, procs, tq));
+    WorkloadShape w = inspectWorkload(procs);
+    EngineKind k = engineSupports(engineOverride, choice, w) ? engineOverride : chooseEngine(choice, w);
+    return runEngineKind(k, choice, procs, tq, w, compact);
+}
+
+Timeline runPolicyQuiet(int choice, vector<Process> &procs, int tq) {
+    bool tick = rqTrace || (engineOverride == EngineKind::Tick && !engineTuned());
+    if (tick && choice != 5) return runTickSimulator(choice, procs, tq);
+    return toTimeline(runPolicySchedule(choice, procs, tq));
+}
+
+// Summary metrics of a quiet run, without materializing a per-tick timeline
+Metrics runPolicyMetrics(int choice, vector<Process> &procs, int tq) {
+    Schedule s = runPolicySchedule(choice, procs, tq, true);
+    return computeMetrics(procs, s);
+}
+
+string policyName(int choice, int tq) {
+    switch (choice) {
+        case 1: return "FCFS";
+        case 2: return "SRTF";
+        case 3: return "Preemptive Priority";
+        case 4: return "Round Robin (q=" + to_string(tq) + ")";
+        case 5: return "EEVDF (slice=" + to_string(tq) + ")";
+    }
+    return "Unknown";
+}
+
+// ---------------------------------------------------------------------------
+// Run-queue lock contention model
+// ---------------------------------------------------------------------------
+// Every dispatch costs two run-queue operations (dequeue the next process and
+// enqueue either an arrival or the preempted process), each holding the queue
+// lock. FIFO policies hold it for `hold` units; keyed policies (SRTF, Priority)
+// pay a heap-style log2(ready) factor. The run segments between dispatches are
+// taken from the policy's own single-CPU timeline and replayed on every CPU.
+
+struct DispatchSegment {
+    int length = 0;          // CPU time until the next dispatch
+    double holdFactor = 1;   // lock hold multiplier for this dispatch
+};
+
+vector<DispatchSegment> profileDispatches(int choice, const vector<Process> &procs, const Timeline &g) {
+    vector<int> arrivals, completions;
+    for (auto &p : procs) { arrivals.push_back(p.arrival); completions.push_back(p.completion); }
+    sort(arrivals.begin(), arrivals.end());
+    sort(completions.begin(), completions.end());
+    bool keyed = (choice == 2 || choice == 3);
+
+    vector<DispatchSegment> segs;
+    int prev = 0, begin = 0;
+    for (int t = 0; t <= (int)g.size(); ++t) {
+        int cur = t < (int)g.size() ? g[t] : 0;
+        if (cur == prev) continue;
+        if (prev != 0) {
+            DispatchSegment s;
+            s.length = t - begin;
+            if (keyed) {
+                long long arrived = upper_bound(arrivals.begin(), arrivals.end(), begin) - arrivals.begin();
+                long long done = upper_bound(completions.begin(), completions.end(), begin) - completions.begin();
+                s.holdFactor = 1.0 + log2((double)max(1LL, arrived - done));
+            }
+            segs.push_back(s);
+        }
+        prev = cur;
+        begin = t;
+    }
+    return segs;
+}
+
+struct LockRunResult {
+    double throughput = 0;      // useful work per unit time, all CPUs
+    double avgWait = 0;         // lock wait per dispatch
+};
+
+// Discrete-event run of `cpus` CPUs cycling through the dispatch segments.
+// Requests are served in time order, so every lock behaves as a FIFO server.
+LockRunResult simulateLockContention(const vector<DispatchSegment> &segs, int cpus, bool perCPU,
+                                     double hold, int balanceEvery, int dispatchesPerCPU) {
+    LockRunResult r;
+    if (segs.empty()) return r;
+    vector<double> lockFree(perCPU ? cpus : 1, 0.0);
+    vector<size_t> cursor(cpus);
+    vector<int> done(cpus, 0);
+    mt19937 rng(12345);
+    using Req = pair<double, int>; // request time, cpu
+    priority_queue<Req, vector<Req>, greater<Req>> pq;
+    for (int c = 0; c < cpus; ++c) {
+        cursor[c] = (size_t)c * segs.size() / cpus;
+        pq.push({0.0, c});
+    }
+    double work = 0, waited = 0, finish = 0;
+    long long dispatches = 0;
+    while (!pq.empty()) {
+        auto [t, c] = pq.top(); pq.pop();
+        const DispatchSegment &s = segs[cursor[c]];
+        cursor[c] = (cursor[c] + 1) % segs.size();
+        double h = 2 * hold * s.holdFactor;
+        int own = perCPU ? c : 0;
+        double acquired = max(t, lockFree[own]);
+        lockFree[own] = acquired + h;
+        double ready = acquired + h;
+        if (perCPU && cpus > 1 && balanceEvery > 0 && done[c] % balanceEvery == balanceEvery - 1) {
+            // periodic balancing pulls work from a random remote queue
+            int victim = (int)(rng() % (cpus - 1));
+            if (victim >= c) victim++;
+            double stolen = max(ready, lockFree[victim]);
+            lockFree[victim] = stolen + h;
+            waited += stolen - ready;
+            ready = stolen + h;
+        }
+        waited += acquired - t;
+        dispatches++;
+        work += s.length;
+        double next = ready + s.length;
+        finish = max(finish, next);
+        if (++done[c] < dispatchesPerCPU) pq.push({next, c});
+    }
+    r.throughput = work / max(1e-9, finish);
+    r.avgWait = waited / max(1LL, dispatches);
+    return r;
+}
+
+void runLockContentionModel(const vector<Process> &base, int tq, double hold, int balanceEvery) {
+    cout << "=== Run-queue Lock Contention Model (hold=" << hold
+         << ", balance every " << balanceEvery << " dispatches) ===\n";
+    const int dispatchesPerCPU = 1000;
+    for (int choice = 1; choice <= 4; ++choice) {
+        auto procs = base;
+        Timeline g = runPolicyQuiet(choice, procs, tq);
+        vector<DispatchSegment> segs = profileDispatches(choice, procs, g);
+        if (segs.empty()) continue;
+        double avgLen = 0, avgHold = 0;
+        for (auto &s : segs) { avgLen += s.length; avgHold += 2 * hold * s.holdFactor; }
+        avgLen /= segs.size(); avgHold /= segs.size();
+
+        cout << "\n--- " << policyName(choice, tq) << ": " << segs.size() << " dispatches, avg segment "
+             << fixed << setprecision(3) << avgLen << ", lock hold/dispatch " << avgHold << " ---\n";
+        cout << " CPUs |  Global thr   eff%   wait/disp |  PerCPU thr   eff%   wait/disp\n";
+        int globalCollapse = -1, perCollapse = -1;
+        double globalPeak = 0, perPeak = 0;
+        int globalPeakAt = 1, perPeakAt = 1;
+        for (int cpus = 1; cpus <= 256; cpus *= 2) {
+            LockRunResult gl = simulateLockContention(segs, cpus, false, hold, balanceEvery, dispatchesPerCPU);
+            LockRunResult pc = simulateLockContention(segs, cpus, true, hold, balanceEvery, dispatchesPerCPU);
+            double ge = gl.throughput / cpus * 100.0, pe = pc.throughput / cpus * 100.0;
+            if (gl.throughput > globalPeak) globalPeak = gl.throughput, globalPeakAt = cpus;
+            if (pc.throughput > perPeak) perPeak = pc.throughput, perPeakAt = cpus;
+            if (globalCollapse < 0 && ge < 50.0) globalCollapse = cpus;
+            if (perCollapse < 0 && pe < 50.0) perCollapse = cpus;
+            cout << setw(5) << cpus << " | " << setw(11) << gl.throughput << setw(7) << setprecision(1) << ge
+                 << setw(12) << setprecision(3) << gl.avgWait << " | " << setw(11) << pc.throughput
+                 << setw(7) << setprecision(1) << pe << setw(12) << setprecision(3) << pc.avgWait << "\n";
+        }
+        auto verdict = [](const char *name, int collapse, double peak, int peakAt) {
+            cout << name << ": peak throughput " << setprecision(3) << peak << " at " << peakAt << " CPUs; ";
+            if (collapse > 0) cout << "efficiency drops below 50% at " << collapse << " CPUs\n";
+            else cout << "no collapse up to 256 CPUs\n";
+        };
+        verdict("Global queue ", globalCollapse, globalPeak, globalPeakAt);
+        verdict("Per-CPU queues", perCollapse, perPeak, perPeakAt);
+    }
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Trace replay benchmark
+// ---------------------------------------------------------------------------
+
+// Replay a trace; returns false if an extract-min disagrees with the recorded schedule
+template <class Q>
+bool replayTrace(Q &q, const vector<RQOp> &trace, int n, long long &checksum) {
+    q.reset(n);
+    bool ok = true;
+    for (const RQOp &op : trace) {
+        switch (op.type) {
+            case RQOpType::Insert: q.insert(op.id, op.key); break;
+            case RQOpType::DecreaseKey: q.decreaseKey(op.id, op.key); break;
+            case RQOpType::Remove: q.remove(op.id); break;
+            case RQOpType::ExtractMin: {
+                int id = q.extractMin();
+                checksum += id;
+                if (id != op.id) ok = false;
+                break;
+            }
+        }
+    }
+    return ok;
+}
+
+// True if no key is ever inserted below the last extracted key (radix heap precondition)
+bool traceIsMonotone(const vector<RQOp> &trace) {
+    long long last = LLONG_MIN;
+    for (const RQOp &op : trace) {
+        if (op.type == RQOpType::ExtractMin) last = max(last, op.key);
+        else if (op.type != RQOpType::Remove && op.key < last) return false;
+    }
+    return true;
+}
+
+// Hardware cache-miss counter for the calling thread; reports -1 when unavailable
+struct CacheMissCounter {
+    int fd = -1;
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+    long long stop() {
+#ifdef __linux__
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long v = 0;
+        if (read(fd, &v, sizeof(v)) != (ssize_t)sizeof(v)) return -1;
+        return v;
+#else
+        return -1;
+#endif
+    }
+};
+
+struct ReplayResult {
+    double nsPerOp = 0;
+    double missesPerOp = -1;
+    bool verified = false;
+};
+
+// Replay checksums are stored here so the optimizer must keep the timed replays
+volatile long long replaySink = 0;
+
+template <class Q>
+ReplayResult benchmarkReplay(const vector<RQOp> &trace, int n, long long minOps = 2000000) {
+    ReplayResult r;
+    Q q;
+    long long checksum = 0;
+    r.verified = replayTrace(q, trace, n, checksum); // warm-up and correctness check
+    long long reps = max(3LL, minOps / max<long long>(1, (long long)trace.size()));
+    CacheMissCounter misses;
+    misses.start();
+    auto t0 = chrono::steady_clock::now();
+    for (long long i = 0; i < reps; ++i) replayTrace(q, trace, n, checksum);
+    auto t1 = chrono::steady_clock::now();
+    long long m = misses.stop();
+    double ops = (double)reps * trace.size();
+    r.nsPerOp = chrono::duration<double, nano>(t1 - t0).count() / max(1.0, ops);
+    if (m >= 0) r.missesPerOp = m / max(1.0, ops);
+    replaySink = checksum;
+    return r;
+}
+
+void writeTraceCSV(const vector<RQOp> &trace, const string &path) {
+    ofstream out(path);
+    if (!out) { cerr << "Failed to write trace file: " << path << "\n"; return; }
+    static const char *names[] = {"insert", "extract_min", "decrease_key", "remove"};
+    out << "op,id,key\n";
+    for (auto &op : trace) out << names[(int)op.type] << "," << op.id << "," << op.key << "\n";
+    cout << "Wrote " << trace.size() << " operations to " << path << "\n";
+}
+
+void runReadyQueueBenchmark(const vector<Process> &base, int choice, int tq, const string &exportPath) {
+    cout << "=== Ready-queue Trace Replay: " << policyName(choice, tq) << " ===\n";
+    vector<RQOp> trace;
+    auto procs = base;
+    rqTrace = &trace;
+    runPolicyQuiet(choice, procs, tq);
+    rqTrace = nullptr;
+    int n = (int)procs.size();
+
+    size_t counts[4] = {0, 0, 0, 0};
+    for (auto &op : trace) counts[(int)op.type]++;
+    cout << "Trace: " << trace.size() << " ops (insert=" << counts[0] << ", extract-min=" << counts[1]
+         << ", decrease-key=" << counts[2] << ", remove=" << counts[3] << ")\n";
+    if (!exportPath.empty() && exportPath != "-") writeTraceCSV(trace, exportPath);
+    if (trace.empty()) return;
+
+    cout << left << setw(16) << "Structure" << right << setw(10) << "ns/op"
+         << setw(16) << "misses/op" << setw(10) << "verified" << "\n";
+    auto row = [](const string &name, const ReplayResult &r) {
+        cout << left << setw(16) << name << right << fixed << setprecision(2) << setw(10) << r.nsPerOp;
+        if (r.missesPerOp >= 0) cout << setw(16) << setprecision(4) << r.missesPerOp;
+        else cout << setw(16) << "n/a";
+        cout << setw(10) << (r.verified ? "ok" : "MISMATCH") << "\n";
+    };
+    row("binary heap", benchmarkReplay<BinaryHeapRQ>(trace, n));
+    row("4-ary heap", benchmarkReplay<DaryHeapRQ<4>>(trace, n));
+    row("8-ary heap", benchmarkReplay<DaryHeapRQ<8>>(trace, n));
+    row("pairing heap", benchmarkReplay<PairingHeapRQ>(trace, n));
+    if (traceIsMonotone(trace)) row("radix heap", benchmarkReplay<RadixHeapRQ>(trace, n));
+    else cout << left << setw(16) << "radix heap" << right << "  skipped (keys are not monotone for this policy)\n";
+    row("skiplist", benchmarkReplay<SkipListRQ>(trace, n));
+    row("rbtree", benchmarkReplay<RBTreeRQ>(trace, n));
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Relaxed concurrent priority scheduling (MultiQueue)
+// ---------------------------------------------------------------------------
+// A MultiQueue keeps c sequential heaps ("shards"). Insert goes to a random
+// shard; delete-min looks at the tops of two random shards and pops the better
+// one. Shards are guarded by try-locks, so a thread never waits on a busy shard,
+// it simply samples another pair. The price is rank error: the popped element is
+// only approximately the global minimum.
+
+class MultiQueue {
+public:
+    explicit MultiQueue(int shards) : shards_(max(1, shards)) {}
+
+    void push(long long key, mt19937 &rng) {
+        while (true) {
+            Shard &s = shards_[rng() % shards_.size()];
+            if (s.lock.test_and_set(memory_order_acquire)) continue;
+            s.heap.push_back(key);
+            push_heap(s.heap.begin(), s.heap.end(), greater<long long>());
+            s.top.store(s.heap.front(), memory_order_relaxed);
+            s.lock.clear(memory_order_release);
+            return;
+        }
+    }
+
+    // Pops an approximately minimal key; returns false if the queue looked empty
+    bool pop(long long &key, mt19937 &rng) {
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            Shard &a = shards_[rng() % shards_.size()];
+            Shard &b = shards_[rng() % shards_.size()];
+            Shard &s = a.top.load(memory_order_relaxed) <= b.top.load(memory_order_relaxed) ? a : b;
+            if (s.top.load(memory_order_relaxed) == LLONG_MAX) continue;
+            if (s.lock.test_and_set(memory_order_acquire)) continue;
+            bool got = !s.heap.empty();
+            if (got) {
+                pop_heap(s.heap.begin(), s.heap.end(), greater<long long>());
+                key = s.heap.back();
+                s.heap.pop_back();
+                s.top.store(s.heap.empty() ? LLONG_MAX : s.heap.front(), memory_order_relaxed);
+            }
+            s.lock.clear(memory_order_release);
+            if (got) return true;
+        }
+        return false;
+    }
+
+private:
+    struct alignas(64) Shard {
+        atomic_flag lock = ATOMIC_FLAG_INIT;
+        atomic<long long> top{LLONG_MAX};
+        vector<long long> heap;
+    };
+    vector<Shard> shards_;
+};
+
+// Strict baseline: one heap behind one mutex
+class LockedHeap {
+public:
+    void push(long long key, mt19937 &) {
+        lock_guard<mutex> g(m_);
+        heap_.push(key);
+    }
+    bool pop(long long &key, mt19937 &) {
+        lock_guard<mutex> g(m_);
+        if (heap_.empty()) return false;
+        key = heap_.top();
+        heap_.pop();
+        return true;
+    }
+
+private:
+    mutex m_;
+    priority_queue<long long, vector<long long>, greater<long long>> heap_;
+};
+
+// Each thread alternates insert / delete-min on a prefilled queue; returns Mops/s
+template <class Q>
+double benchmarkConcurrentQueue(Q &q, int threads, int opsPerThread, int prefill) {
+    mt19937 seed(99);
+    for (int i = 0; i < prefill; ++i) q.push(seed() % 1000000, seed);
+    atomic<bool> go{false};
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            mt19937 rng(1000 + t);
+            long long k;
+            while (!go.load(memory_order_acquire)) this_thread::yield();
+            for (int i = 0; i < opsPerThread; ++i) {
+                if (q.pop(k, rng)) q.push(k + rng() % 1000, rng);
+            }
+        });
+    }
+    auto t0 = chrono::steady_clock::now();
+    go.store(true, memory_order_release);
+    for (auto &w : workers) w.join();
+    auto t1 = chrono::steady_clock::now();
+    double secs = chrono::duration<double>(t1 - t0).count();
+    return 2.0 * threads * opsPerThread / max(1e-9, secs) / 1e6;
+}
+
+struct RelaxedStats {
+    double avgRankError = 0;
+    int maxRankError = 0;
+    long long dispatches = 0;
+};
+
+// SRTF (byPriority=false) or Preemptive Priority (byPriority=true) where each
+// tick the dispatcher only inspects the tops of two random shards. shards=1 is
+// exactly the strict policy.
+Timeline simulateRelaxedPolicy(vector<Process> &procs, bool byPriority, int shards, mt19937 &rng,
+                               RelaxedStats &stats) {
+    int n = (int)procs.size();
+    resetProcesses(procs);
+    auto key = [&](int i) {
+        return byPriority ? rqKey(procs[i].priority, procs[i].remaining) : rqKey(procs[i].remaining, 0);
+    };
+    vector<set<pair<long long, int>>> shard(shards);
+    vector<int> byArrival(n);
+    iota(byArrival.begin(), byArrival.end(), 0);
+    stable_sort(byArrival.begin(), byArrival.end(), [&](int a, int b){ return procs[a].arrival < procs[b].arrival; });
+    size_t nextArrival = 0;
+    auto enqueue = [&](int i) { shard[rng() % shards].insert({key(i), i}); };
+
+    Timeline gantt;
+    int cur = 0, completed = 0, running = -1;
+    double rankSum = 0;
+    while (completed < n) {
+        while (nextArrival < byArrival.size() && procs[byArrival[nextArrival]].arrival <= cur)
+            enqueue(byArrival[nextArrival++]);
+        // sample two shards and take the better top
+        int a = (int)(rng() % shards), b = (int)(rng() % shards);
+        int pick = -1;
+        for (int s : {a, b}) {
+            if (shard[s].empty()) continue;
+            if (pick < 0 || *shard[s].begin() < *shard[pick].begin()) pick = s;
+        }
+        if (pick < 0) {
+            // both sampled shards empty: fall back to any non-empty one
+            for (int s = 0; s < shards; ++s) if (!shard[s].empty()) { pick = s; break; }
+        }
+        if (pick >= 0 && (running < 0 || *shard[pick].begin() < make_pair(key(running), running))) {
+            int idx = shard[pick].begin()->second;
+            long long chosen = shard[pick].begin()->first;
+            shard[pick].erase(shard[pick].begin());
+            if (running >= 0) enqueue(running);
+            running = idx;
+            int rank = 0;
+            for (auto &sh : shard) for (auto &e : sh) { if (e.first < chosen) rank++; else break; }
+            rankSum += rank;
+            stats.maxRankError = max(stats.maxRankError, rank);
+            stats.dispatches++;
+        }
+        if (running < 0) { gantt.push_back(0); cur++; continue; }
+        Process &p = procs[running];
+        if (p.start == -1) p.start = cur, p.response = cur - p.arrival;
+        gantt.push_back(p.pid);
+        p.remaining--;
+        cur++;
+        if (p.remaining == 0) {
+            p.completion = cur;
+            completed++;
+            running = -1;
+        }
+    }
+    stats.avgRankError = rankSum / max(1LL, stats.dispatches);
+    return gantt;
+}
+
+void runRelaxedPriorityAnalysis(const vector<Process> &base) {
+    cout << "=== Relaxed Priority Scheduling (MultiQueue) ===\n";
+    cout << "\nQuality loss vs strict ordering (tick simulation, 20 seeds per shard count):\n";
+    for (bool byPriority : {false, true}) {
+        cout << "\n--- " << (byPriority ? "Preemptive Priority" : "SRTF") << " ---\n";
+        cout << "Shards  AvgRankErr  MaxRankErr   AvgWT   ExtraWT  AvgResp  CtxSw\n";
+        double strictWT = 0;
+        for (int shards : {1, 2, 4, 8, 16}) {
+            int seeds = shards == 1 ? 1 : 20;
+            double rank = 0, wt = 0, resp = 0, cs = 0;
+            int maxRank = 0;
+            for (int sd = 0; sd < seeds; ++sd) {
+                mt19937 rng(7919 * sd + shards);
+                RelaxedStats st;
+                auto procs = base;
+                Timeline g = simulateRelaxedPolicy(procs, byPriority, shards, rng, st);
+                Metrics m = computeMetrics(procs, g);
+                rank += st.avgRankError; wt += m.avgWaiting; resp += m.avgResponse; cs += m.contextSwitches;
+                maxRank = max(maxRank, st.maxRankError);
+            }
+            rank /= seeds; wt /= seeds; resp /= seeds; cs /= seeds;
+            if (shards == 1) strictWT = wt;
+            cout << fixed << setprecision(3) << setw(6) << shards << setw(12) << rank << setw(12) << maxRank
+                 << setw(8) << wt << setw(10) << (wt - strictWT) << setw(9) << resp
+                 << setw(7) << setprecision(1) << cs << "\n";
+        }
+    }
+
+    int hw = max(1u, thread::hardware_concurrency());
+    const int opsPerThread = 200000, prefill = 100000;
+    cout << "\nConcurrent throughput (insert+delete-min pairs, prefill " << prefill << ", Mops/s):\n";
+    cout << "Threads  LockedHeap  MultiQueue(c=2T)  MultiQueue(c=4T)\n";
+    for (int t = 1; t <= max(8, 2 * hw); t *= 2) {
+        LockedHeap strict;
+        MultiQueue mq2(2 * t), mq4(4 * t);
+        double s = benchmarkConcurrentQueue(strict, t, opsPerThread, prefill);
+        double r2 = benchmarkConcurrentQueue(mq2, t, opsPerThread, prefill);
+        double r4 = benchmarkConcurrentQueue(mq4, t, opsPerThread, prefill);
+        cout << setw(7) << t << setw(12) << setprecision(2) << s << setw(18) << r2 << setw(18) << r4 << "\n";
+    }
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Engine chooser benchmark
+// ---------------------------------------------------------------------------
+
+// Average wall time (microseconds) of one engine run, repeated for at least ~20 ms
+double timeEngineKind(EngineKind k, int choice, const vector<Process> &base, int tq, const WorkloadShape &w,
+                      vector<int> &completions) {
+    int reps = 0;
+    double total = 0;
+    while (total < 20000 || reps < 3) {
+        auto procs = base;
+        auto t0 = chrono::steady_clock::now();
+        if (k == EngineKind::Tick) runTickSimulator(choice, procs, tq);
+        else runEngineKind(k, choice, procs, tq, w);
+        auto t1 = chrono::steady_clock::now();
+        total += chrono::duration<double, micro>(t1 - t0).count();
+        reps++;
+        if (reps == 1) {
+            completions.clear();
+            sort(procs.begin(), procs.end(), [](const Process &a, const Process &b){ return a.pid < b.pid; });
+            for (auto &p : procs) completions.push_back(p.completion);
+        }
+    }
+    return total / reps;
+}
+
+void runEngineChooserBenchmark(const vector<Process> &loaded, int tq) {
+    cout << "=== Engine Chooser Benchmark (RR quantum " << tq << ") ===\n";
+    vector<pair<string, vector<Process>>> cases = {
+        {"loaded workload", loaded},
+        {"tiny n=16", generateWorkload(16, 0.9, 10, 4, 1)},
+        {"light n=20000", generateWorkload(20000, 0.5, 10, 8, 2)},
+        {"overload, 8 prios", generateWorkload(20000, 1.5, 10, 8, 3)},
+        {"overload, wide prios", generateWorkload(20000, 1.5, 10, 100000, 4)},
+    };
+    double logRatio = 0;
+    int rows = 0;
+    cout << left << setw(22) << "Workload" << setw(22) << "Policy" << setw(7) << "peak"
+         << setw(10) << "best" << right << setw(12) << "best us" << "  " << left << setw(10) << "chosen"
+         << right << setw(12) << "chosen us" << setw(8) << "ratio" << "  verified\n";
+    for (auto &[name, procs] : cases) {
+        WorkloadShape w = inspectWorkload(procs);
+        for (int choice = 1; choice <= 4; ++choice) {
+            EngineKind chosen = chooseEngine(choice, w), best = EngineKind::Auto;
+            double bestTime = 1e18, chosenTime = 0;
+            vector<int> reference, completions;
+            bool verified = true;
+            for (auto &[ename, k] : engineNames) {
+                if (k == EngineKind::Auto) continue;
+                if (k == EngineKind::Tick ? w.n > 2000 : !engineSupports(k, choice, w)) continue;
+                double us = timeEngineKind(k, choice, procs, tq, w, completions);
+                if (reference.empty()) reference = completions;
+                else if (completions != reference) verified = false;
+                if (us < bestTime) bestTime = us, best = k;
+                if (k == chosen) chosenTime = us;
+            }
+            double ratio = chosenTime / bestTime;
+            logRatio += log(ratio);
+            rows++;
+            cout << left << setw(22) << name << setw(22) << policyName(choice, tq) << setw(7) << w.peakConcurrency
+                 << setw(10) << engineName(best) << right << fixed << setprecision(1) << setw(12) << bestTime
+                 << "  " << left << setw(10) << engineName(chosen) << right << setw(12) << chosenTime
+                 << setw(8) << setprecision(2) << ratio << "  " << (verified ? "ok" : "MISMATCH") << "\n";
+        }
+    }
+    cout << "Chooser vs best engine: geometric mean slowdown " << fixed << setprecision(3)
+         << exp(logRatio / max(1, rows)) << "x\n\n";
+}
+
+// ---------------------------------------------------------------------------
+// Fixed-capacity engine benchmark
+// ---------------------------------------------------------------------------
+// Many small simulations, as in parameter sweeps: each size runs a batch of
+// distinct generated workloads on the growable engine the chooser would pick
+// otherwise and on the bitset engine, checking that completions agree.
+
+void runBitsetEngineBenchmark(int tq) {
+    cout << "=== Fixed-Capacity Bitset Engine (RR quantum " << tq << ") ===\n";
+    cout << right << setw(6) << "n" << "  " << left << setw(22) << "Policy" << setw(10) << "general" << right
+         << setw(12) << "general us" << setw(12) << "bitset us" << setw(9) << "speedup" << "  verified\n";
+    const int batch = 200;
+    for (int n : {16, 64, 128, 256, 512}) {
+        vector<vector<Process>> workloads;
+        for (int i = 0; i < batch; ++i) workloads.push_back(generateWorkload(n, 0.95, 10, 8, 1000 + i));
+        for (int choice = 1; choice <= 4; ++choice) {
+            vector<WorkloadShape> shapes;
+            for (auto &wl : workloads) shapes.push_back(inspectWorkload(wl));
+            auto timeBatch = [&](bool bitset, vector<int> &completions) {
+                completions.clear();
+                vector<Process> procs;
+                int reps = 0;
+                double total = 0;
+                while (total < 20000 || reps < 3) {
+                    auto t0 = chrono::steady_clock::now();
+                    for (int i = 0; i < batch; ++i) {
+                        procs = workloads[i];
+                        EngineKind k = bitset ? EngineKind::Bitset : chooseGeneralEngine(choice, shapes[i]);
+                        runEngineKind(k, choice, procs, tq, shapes[i], true);
+                        if (reps == 0) for (auto &p : procs) completions.push_back(p.completion);
+                    }
+                    total += chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count();
+                    reps++;
+                }
+                return total / reps / batch;
+            };
+            vector<int> growableCompletions, bitsetCompletions;
+            double g = timeBatch(false, growableCompletions), b = timeBatch(true, bitsetCompletions);
+            cout << setw(6) << n << "  " << left << setw(22) << policyName(choice, tq) << setw(10)
+                 << engineName(chooseGeneralEngine(choice, shapes[0])) << right << fixed << setprecision(2)
+                 << setw(12) << g << setw(12) << b << setw(8) << g / b << "x  "
+                 << (growableCompletions == bitsetCompletions ? "ok" : "MISMATCH") << "\n";
+        }
+    }
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Latency breakdown
+// ---------------------------------------------------------------------------
+// Splits each process's waiting time into initial queueing, time preempted and
+// context-switch overhead (tracked online by the event engine) and aggregates
+// the components per policy.
+
+void runLatencyBreakdown(const vector<Process> &base, int tq, int switchCost) {
+    cout << "=== Latency Breakdown (switch cost " << switchCost << ") ===\n";
+    int savedCost = contextSwitchCost;
+    contextSwitchCost = switchCost;
+    cout << left << setw(22) << "Policy" << right << setw(10) << "AvgWT" << setw(11) << "Queueing"
+         << setw(11) << "Preempted" << setw(10) << "Switch" << setw(9) << "Queue%" << setw(9) << "Preempt%"
+         << setw(9) << "Switch%" << "\n";
+    for (int choice = 1; choice <= 4; ++choice) {
+        auto procs = base;
+        WorkloadShape w = inspectWorkload(procs);
+        Schedule s = runEngineKind(chooseEngine(choice, w), choice, procs, tq, w, true);
+        Metrics m = computeMetrics(procs, s);
+        double q = 0, pre = 0, sw = 0;
+        for (auto &p : procs) { q += p.queueing; pre += p.preempted; sw += p.switchOverhead; }
+        int n = max(1, (int)procs.size());
+        q /= n; pre /= n; sw /= n;
+        double total = max(1e-9, q + pre + sw);
+        cout << left << setw(22) << policyName(choice, tq) << right << fixed << setprecision(3)
+             << setw(10) << m.avgWaiting << setw(11) << q << setw(11) << pre << setw(10) << sw
+             << setprecision(1) << setw(9) << q / total * 100 << setw(9) << pre / total * 100
+             << setw(9) << sw / total * 100 << "\n";
+        if (procs.size() <= 20) {
+            for (auto &p : procs)
+                cout << "    P" << p.pid << " : WT=" << p.waiting << " = queueing " << p.queueing
+                     << " + preempted " << p.preempted << " + switch " << p.switchOverhead << "\n";
+        }
+    }
+    contextSwitchCost = savedCost;
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Preemption tuning sweep
+// ---------------------------------------------------------------------------
+// Runs SRTF and Priority over a grid of preemption thresholds and minimum
+// granularities, and marks the settings on the Pareto front of context switches
+// versus average response time (lower is better on both).
+
+void runPreemptionSweep(const vector<Process> &base, int switchCost) {
+    const vector<int> thresholds = {0, 1, 2, 4, 8, 16};
+    const vector<int> granularities = {0, 1, 2, 4, 8};
+    int savedCost = contextSwitchCost, savedThr = preemptThreshold, savedGran = minGranularity;
+    contextSwitchCost = switchCost;
+    cout << "=== Preemption Threshold / Minimum Granularity Sweep (switch cost " << switchCost << ") ===\n";
+    for (int choice : {2, 3}) {
+        struct Point { int thr, gran; Metrics m; };
+        vector<Point> points;
+        for (int thr : thresholds)
+            for (int gran : granularities) {
+                preemptThreshold = thr;
+                minGranularity = gran;
+                auto procs = base;
+                points.push_back({thr, gran, runPolicyMetrics(choice, procs, 1)});
+            }
+        cout << policyName(choice, 1) << ":\n";
+        cout << right << setw(6) << "Thr" << setw(6) << "Gran" << setw(8) << "CS" << setw(10) << "AvgWT"
+             << setw(10) << "AvgRT" << setw(10) << "AvgTAT" << "  Pareto\n";
+        for (auto &pt : points) {
+            bool dominated = false;
+            for (auto &o : points) {
+                bool noWorse = o.m.contextSwitches <= pt.m.contextSwitches && o.m.avgResponse <= pt.m.avgResponse;
+                bool better = o.m.contextSwitches < pt.m.contextSwitches || o.m.avgResponse < pt.m.avgResponse;
+                if (noWorse && better) { dominated = true; break; }
+            }
+            cout << setw(6) << pt.thr << setw(6) << pt.gran << setw(8) << pt.m.contextSwitches << fixed
+                 << setprecision(3) << setw(10) << pt.m.avgWaiting << setw(10) << pt.m.avgResponse
+                 << setw(10) << pt.m.avgTurnaround << (dominated ? "" : "  *") << "\n";
+        }
+    }
+    contextSwitchCost = savedCost;
+    preemptThreshold = savedThr;
+    minGranularity = savedGran;
+    cout << "(* = Pareto-optimal in context switches vs average response time)\n\n";
+}
+
+// ---------------------------------------------------------------------------
+// Per-class SLO reporting
+// ---------------------------------------------------------------------------
+// Completed processes are folded into one accumulator per request class: running
+// sums plus fixed-size log-bucketed histograms, so memory and report cost depend
+// on the number of classes, not on the number of processes. An SLO is a
+// turnaround target that a given percentage of the class must meet (--slo).
+
+struct ClassSLO {
+    int target = 0;           // max turnaround (time units), 0 = no SLO
+    double objective = 95.0;  // percent of processes that must meet the target
+};
+map<string, ClassSLO> classSLOs;
+
+// Histogram with exact buckets below 16 and 16 sub-buckets per power of two
+// above (relative error under 6.25%)
+class LogHistogram {
+public:
+    void add(long long v) {
+        v = max(0LL, v);
+        buckets_[bucketOf(v)]++;
+        count_++;
+        max_ = max(max_, v);
+    }
+    long long count() const { return count_; }
+    // Midpoint of the bucket holding the q-quantile, capped at the largest value seen
+    long long quantile(double q) const {
+        if (count_ == 0) return 0;
+        long long target = max(1LL, (long long)ceil(q * count_)), seen = 0;
+        for (int b = 0; b < Buckets; ++b)
+            if ((seen += buckets_[b]) >= target) return min(max_, (lowerBound(b) + lowerBound(b + 1) - 1) / 2);
+        return max_;
+    }
+
+private:
+    static const int Buckets = 16 + 59 * 16;
+    static int bucketOf(long long v) {
+        if (v < 16) return (int)v;
+        int e = 63 - __builtin_clzll((unsigned long long)v);
+        return 16 + (e - 4) * 16 + (int)((v >> (e - 4)) & 15);
+    }
+    static long long lowerBound(int b) {
+        if (b < 16) return b;
+        int e = (b - 16) / 16 + 4;
+        return (16LL + (b - 16) % 16) << (e - 4);
+    }
+    array<long long, Buckets> buckets_{};
+    long long count_ = 0, max_ = 0;
+};
+
+struct ClassStats {
+    long long n = 0;
+    double sumWaiting = 0, sumTurnaround = 0, sumResponse = 0;
+    LogHistogram turnaround, response;
+    long long metSLO = 0;
+};
+
+class ClassAccumulator {
+public:
+    void add(const Process &p) {
+        if ((size_t)p.cls >= stats_.size()) stats_.resize(p.cls + 1);
+        ClassStats &c = stats_[p.cls];
+        c.n++;
+        c.sumWaiting += p.waiting;
+        c.sumTurnaround += p.turnaround;
+        c.sumResponse += p.response;
+        c.turnaround.add(p.turnaround);
+        c.response.add(p.response);
+        int target = sloFor(p.cls).target;
+        if (target > 0 && p.turnaround <= target) c.metSLO++;
+    }
+    void print() const {
+        cout << left << setw(14) << "Class" << right << setw(9) << "N" << setw(9) << "AvgWT" << setw(9) << "AvgTAT"
+             << setw(9) << "AvgResp" << setw(8) << "p50TAT" << setw(8) << "p95TAT" << setw(8) << "p99TAT"
+             << setw(9) << "p99Resp" << setw(12) << "SLO" << setw(9) << "Attain%" << "\n";
+        for (size_t c = 0; c < stats_.size(); ++c) {
+            const ClassStats &s = stats_[c];
+            if (s.n == 0) continue;
+            ClassSLO slo = sloFor((int)c);
+            cout << left << setw(14) << classNames[c] << right << setw(9) << s.n << fixed << setprecision(2)
+                 << setw(9) << s.sumWaiting / s.n << setw(9) << s.sumTurnaround / s.n << setw(9) << s.sumResponse / s.n
+                 << setw(8) << s.turnaround.quantile(0.5) << setw(8) << s.turnaround.quantile(0.95)
+                 << setw(8) << s.turnaround.quantile(0.99) << setw(9) << s.response.quantile(0.99);
+            if (slo.target > 0) {
+                double attain = 100.0 * s.metSLO / s.n;
+                ostringstream spec;
+                spec << "p" << slo.objective << "<=" << slo.target;
+                cout << setw(12) << spec.str() << setw(9) << setprecision(1) << attain
+                     << (attain >= slo.objective ? "  met" : "  MISSED");
+            }
+            cout << "\n";
+        }
+    }
+
+private:
+    static ClassSLO sloFor(int cls) {
+        auto it = classSLOs.find(classNames[cls]);
+        return it == classSLOs.end() ? ClassSLO() : it->second;
+    }
+    vector<ClassStats> stats_;
+};
+
+// Parse --slo=<class>:<max turnaround>[:<percent>]
+bool parseSLOFlag(const string &spec) {
+    vector<string> parts;
+    stringstream ss(spec);
+    string part;
+    while (getline(ss, part, ':')) parts.push_back(part);
+    if (parts.size() < 2 || parts.size() > 3 || parts[0].empty()) return false;
+    ClassSLO slo;
+    slo.target = atoi(parts[1].c_str());
+    if (parts.size() == 3) slo.objective = atof(parts[2].c_str());
+    if (slo.target <= 0 || slo.objective <= 0 || slo.objective > 100) return false;
+    classSLOs[parts[0]] = slo;
+    return true;
+}
+
+void runClassReport(const vector<Process> &base, int tq) {
+    cout << "=== Per-Class SLO Report ===\n";
+    for (int choice = 1; choice <= 4; ++choice) {
+        auto procs = base;
+        runPolicyMetrics(choice, procs, tq);
+        ClassAccumulator acc;
+        for (auto &p : procs) acc.add(p);
+        cout << policyName(choice, tq) << ":\n";
+        acc.print();
+    }
+    if (classSLOs.empty()) cout << "(no SLOs set; use --slo=<class>:<max turnaround>[:<percent>])\n";
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Mixed-criticality periodic tasks
+// ---------------------------------------------------------------------------
+// Each task has a LO and a HI budget; a HI task may overrun its LO budget (up to
+// its HI budget). Criticality-aware policies switch to HI mode at the first
+// overrun, drop all LO jobs while in HI mode and return to LO mode at the next
+// idle instant. EDF-VD runs HI jobs against shortened virtual deadlines in LO
+// mode; AMC runs fixed deadline-monotonic priorities (analysed with AMC-rtb).
+// Plain EDF and FP are the criticality-unaware baselines.
+
+struct MCTask {
+    string name;
+    int period = 1;
+    int deadline = 1;     // relative deadline <= period
+    bool hi = false;      // criticality
+    int cLo = 1, cHi = 1; // budgets at LO and HI criticality (cHi == cLo for LO tasks)
+};
+
+struct MCJob {
+    int task = 0;
+    int release = 0, deadline = 0;
+    int demand = 0;       // actual execution time of this job
+    int done = 0;
+};
+
+// CSV: name,period,deadline,crit(LO/HI),clo,chi with an optional header line
+vector<MCTask> readMCTasks(const string &path) {
+    ifstream fin(path);
+    if (!fin.is_open()) throw runtime_error("Cannot open task set " + path);
+    vector<MCTask> tasks;
+    string line;
+    while (getline(fin, line)) {
+        if (line.empty()) continue;
+        stringstream ss(line);
+        vector<string> f;
+        string tok;
+        while (getline(ss, tok, ',')) f.push_back(tok);
+        if (f.size() != 6) throw runtime_error("Task set row needs name,period,deadline,crit,clo,chi");
+        if (tasks.empty() && !isdigit((unsigned char)f[1][0])) continue; // header
+        MCTask t;
+        t.name = f[0];
+        t.period = stoi(f[1]);
+        t.deadline = min(t.period, stoi(f[2]));
+        t.hi = f[3].find("HI") != string::npos || f[3].find("hi") != string::npos;
+        t.cLo = stoi(f[4]);
+        t.cHi = t.hi ? max(t.cLo, stoi(f[5])) : t.cLo;
+        if (t.period <= 0 || t.deadline <= 0 || t.cLo <= 0) throw runtime_error("Invalid task " + t.name);
+        tasks.push_back(t);
+    }
+    return tasks;
+}
+
+// UUniFast LO-mode utilizations, log-uniform periods in [10, 1000], every other
+// task HI with a HI budget 1.5-3x its LO budget, implicit deadlines
+vector<MCTask> generateMCTasks(int n, double util, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    vector<MCTask> tasks(n);
+    double sum = util;
+    for (int i = 0; i < n; ++i) {
+        double next = i + 1 < n ? sum * pow(unit(rng), 1.0 / (n - i - 1)) : 0.0;
+        double u = sum - next;
+        sum = next;
+        MCTask &t = tasks[i];
+        t.name = "T" + to_string(i + 1);
+        t.period = (int)round(10 * pow(100.0, unit(rng)));
+        t.deadline = t.period;
+        t.hi = i % 2 == 0;
+        t.cLo = max(1, min(t.period, (int)round(u * t.period)));
+        t.cHi = t.hi ? min(t.period, (int)ceil(t.cLo * (1.5 + 1.5 * unit(rng)))) : t.cLo;
+    }
+    return tasks;
+}
+
+struct EDFVDTest {
+    double uLoLo = 0, uHiLo = 0, uHiHi = 0; // density of LO tasks, HI tasks at LO and at HI budgets
+    double x = 1;                           // virtual deadline factor for HI tasks in LO mode
+    bool schedulable = false;
+};
+
+EDFVDTest edfVDTest(const vector<MCTask> &tasks) {
+    EDFVDTest r;
+    for (auto &t : tasks) {
+        if (t.hi) { r.uHiLo += (double)t.cLo / t.deadline; r.uHiHi += (double)t.cHi / t.deadline; }
+        else r.uLoLo += (double)t.cLo / t.deadline;
+    }
+    if (r.uLoLo + r.uHiHi <= 1) { r.schedulable = true; return r; }
+    if (r.uLoLo >= 1) return r;
+    r.x = r.uHiLo / (1 - r.uLoLo);
+    r.schedulable = r.x <= 1 && r.x * r.uLoLo + r.uHiHi <= 1;
+    return r;
+}
+
+// Deadline-monotonic priority ranks (0 = highest)
+vector<int> deadlineMonotonicRanks(const vector<MCTask> &tasks) {
+    vector<int> order(tasks.size()), rank(tasks.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b){ return tasks[a].deadline < tasks[b].deadline; });
+    for (size_t r = 0; r < order.size(); ++r) rank[order[r]] = (int)r;
+    return rank;
+}
+
+// Fixed-point response time: base + sum over hp of ceil(R / T_j) * cost(j), or
+// INT_MAX once it exceeds the limit
+int responseTime(int base, const vector<pair<int, int>> &interference, int limit, int fixedExtra = 0) {
+    long long r = base + fixedExtra, prev = -1;
+    while (r != prev) {
+        if (r > limit) return INT_MAX;
+        prev = r;
+        r = base + fixedExtra;
+        for (auto &[period, cost] : interference) r += (prev + period - 1) / period * cost;
+    }
+    return (int)r;
+}
+
+// AMC-rtb under the given ranks: rLo for every task, rHi for HI tasks (INT_MAX = unbounded)
+bool amcRtbTest(const vector<MCTask> &tasks, const vector<int> &rank, vector<int> &rLo, vector<int> &rHi) {
+    int n = (int)tasks.size();
+    rLo.assign(n, INT_MAX);
+    rHi.assign(n, 0);
+    bool ok = true;
+    for (int i = 0; i < n; ++i) {
+        vector<pair<int, int>> hpLo, hpHi;
+        for (int j = 0; j < n; ++j) {
+            if (rank[j] >= rank[i]) continue;
+            hpLo.push_back({tasks[j].period, tasks[j].cLo});
+            if (tasks[j].hi) hpHi.push_back({tasks[j].period, tasks[j].cHi});
+        }
+        rLo[i] = responseTime(tasks[i].cLo, hpLo, tasks[i].deadline);
+        if (rLo[i] == INT_MAX) { ok = false; if (tasks[i].hi) rHi[i] = INT_MAX; continue; }
+        if (!tasks[i].hi) continue;
+        // LO interference is frozen at the mode switch, which happens no later than rLo
+        long long loCarry = 0;
+        for (int j = 0; j < n; ++j)
+            if (rank[j] < rank[i] && !tasks[j].hi)
+                loCarry += (long long)(rLo[i] + tasks[j].period - 1) / tasks[j].period * tasks[j].cLo;
+        rHi[i] = responseTime(tasks[i].cHi, hpHi, tasks[i].deadline, (int)min<long long>(loCarry, INT_MAX / 2));
+        if (rHi[i] == INT_MAX) ok = false;
+    }
+    return ok;
+}
+
+enum class MCPolicy { EDF, EDFVD, FP, AMC };
+
+struct MCResult {
+    int modeSwitches = 0;
+    long long hiJobs = 0, hiMiss = 0;
+    long long loJobs = 0, loMiss = 0, loDropped = 0, loDone = 0;
+    vector<int> worstResponse;  // per task, over completed jobs
+};
+
+MCResult simulateMixedCriticality(const vector<MCTask> &tasks, vector<MCJob> jobs, MCPolicy policy, double x,
+                                  const vector<int> &rank) {
+    bool aware = policy == MCPolicy::EDFVD || policy == MCPolicy::AMC;
+    bool hiMode = false;
+    MCResult r;
+    r.worstResponse.assign(tasks.size(), 0);
+    for (auto &j : jobs) (tasks[j.task].hi ? r.hiJobs : r.loJobs)++;
+
+    auto key = [&](int j) -> long long {
+        const MCJob &jb = jobs[j];
+        const MCTask &t = tasks[jb.task];
+        if (policy == MCPolicy::FP || policy == MCPolicy::AMC) return rank[jb.task];
+        if (policy == MCPolicy::EDFVD && !hiMode && t.hi) return jb.release + max(1, (int)floor(x * t.deadline));
+        return jb.deadline;
+    };
+
+    int J = (int)jobs.size();
+    PairingHeapRQ rq;
+    rq.reset(J);
+    vector<int> ready, pos(J, -1);  // queued jobs, for dropping and re-keying at a mode switch
+    auto enqueue = [&](int j) { rq.insert(j, key(j)); pos[j] = (int)ready.size(); ready.push_back(j); };
+    auto unlist = [&](int j) { int last = ready.back(); ready[pos[j]] = last; pos[last] = pos[j]; ready.pop_back(); pos[j] = -1; };
+
+    size_t next = 0;
+    auto release = [&](int now) {
+        while (next < jobs.size() && jobs[next].release <= now) {
+            int j = (int)next++;
+            if (hiMode && !tasks[jobs[j].task].hi) { r.loDropped++; continue; }
+            enqueue(j);
+        }
+    };
+    auto switchToHi = [&] {
+        hiMode = true;
+        r.modeSwitches++;
+        for (int j : vector<int>(ready)) {
+            rq.remove(j);
+            unlist(j);
+            if (!tasks[jobs[j].task].hi) r.loDropped++;
+            else enqueue(j);  // EDF-VD falls back to the real deadline
+        }
+    };
+
+    int now = 0, running = -1;
+    while (true) {
+        release(now);
+        if (running < 0) {
+            if (rq.empty()) {
+                hiMode = false;  // idle instant: back to LO mode
+                if (next >= jobs.size()) break;
+                now = jobs[next].release;
+                continue;
+            }
+            running = rq.extractMin();
+            unlist(running);
+        }
+        MCJob &jb = jobs[running];
+        const MCTask &t = tasks[jb.task];
+        int end = now + (jb.demand - jb.done);
+        if (next < jobs.size()) end = min(end, jobs[next].release);
+        bool overrun = aware && !hiMode && t.hi && jb.done < t.cLo && jb.demand > t.cLo;
+        if (overrun) end = min(end, now + t.cLo - jb.done);
+        jb.done += end - now;
+        now = end;
+        if (jb.done == jb.demand) {
+            r.worstResponse[jb.task] = max(r.worstResponse[jb.task], now - jb.release);
+            if (now > jb.deadline) (t.hi ? r.hiMiss : r.loMiss)++;
+            else if (!t.hi) r.loDone++;
+            running = -1;
+            continue;
+        }
+        if (overrun && jb.done == t.cLo) switchToHi();
+        release(now);
+        enqueue(running);
+        running = rq.extractMin();
+        unlist(running);
+    }
+    return r;
+}
+
+void runMixedCriticality(const vector<MCTask> &tasks, int horizon, double overrunProb, unsigned seed) {
+    if (tasks.empty()) { cout << "Empty task set\n"; return; }
+    // one job set shared by every policy
+    mt19937 rng(seed);
+    bernoulli_distribution overrun(min(1.0, max(0.0, overrunProb)));
+    vector<MCJob> jobs;
+    for (int i = 0; i < (int)tasks.size(); ++i)
+        for (long long rel = 0; rel < horizon; rel += tasks[i].period) {
+            MCJob j;
+            j.task = i;
+            j.release = (int)rel;
+            j.deadline = (int)rel + tasks[i].deadline;
+            j.demand = tasks[i].hi && overrun(rng) ? tasks[i].cHi : tasks[i].cLo;
+            jobs.push_back(j);
+        }
+    sort(jobs.begin(), jobs.end(), [](const MCJob &a, const MCJob &b){
+        return a.release != b.release ? a.release < b.release : a.task < b.task;
+    });
+
+    EDFVDTest vd = edfVDTest(tasks);
+    vector<int> rank = deadlineMonotonicRanks(tasks), rLo, rHi;
+    bool amcOk = amcRtbTest(tasks, rank, rLo, rHi);
+    // criticality-unaware baselines are guaranteed only when every task fits at its HI budget
+    double uWorst = 0;
+    vector<MCTask> worst = tasks;
+    for (auto &t : worst) { uWorst += (double)t.cHi / t.deadline; t.cLo = t.cHi; }
+    vector<int> wLo, wHi;
+    bool fpOk = amcRtbTest(worst, rank, wLo, wHi);
+
+    int hiCount = 0;
+    for (auto &t : tasks) hiCount += t.hi;
+    cout << "=== Mixed-Criticality Scheduling (horizon " << horizon << ", overrun probability " << overrunProb << ") ===\n";
+    cout << fixed << setprecision(3) << tasks.size() << " tasks (" << hiCount << " HI), " << jobs.size()
+         << " jobs; density LO tasks=" << vd.uLoLo << ", HI tasks at LO budget=" << vd.uHiLo
+         << ", at HI budget=" << vd.uHiHi << "\n";
+    cout << "EDF-VD virtual deadline factor x=" << vd.x << "\n";
+
+    struct Row { string name; MCPolicy policy; bool guaranteed; };
+    vector<Row> rows = {
+        {"EDF (unaware)", MCPolicy::EDF, uWorst <= 1},
+        {"EDF-VD", MCPolicy::EDFVD, vd.schedulable},
+        {"FP-DM (unaware)", MCPolicy::FP, fpOk},
+        {"AMC (rtb)", MCPolicy::AMC, amcOk},
+    };
+    cout << left << setw(18) << "Policy" << right << setw(11) << "Guarantee" << setw(8) << "ModeSw" << setw(9) << "HI jobs"
+         << setw(9) << "HI miss" << setw(9) << "LO jobs" << setw(9) << "LO miss" << setw(9) << "LO drop" << setw(10) << "LO done%" << "\n";
+    vector<MCResult> results;
+    for (auto &row : rows) {
+        results.push_back(simulateMixedCriticality(tasks, jobs, row.policy, vd.x, rank));
+        const MCResult &r = results.back();
+        cout << left << setw(18) << row.name << right << setw(11) << (row.guaranteed ? "yes" : "no")
+             << setw(8) << r.modeSwitches << setw(9) << r.hiJobs << setw(9) << r.hiMiss << setw(9) << r.loJobs
+             << setw(9) << r.loMiss << setw(9) << r.loDropped << setw(10) << setprecision(1)
+             << 100.0 * r.loDone / max(1LL, r.loJobs) << "\n";
+    }
+
+    cout << "\nPer-task worst observed response (AMC-rtb bounds; - = unbounded):\n";
+    cout << left << setw(8) << "Task" << setw(5) << "Crit" << right << setw(7) << "T" << setw(7) << "D" << setw(7) << "C(LO)"
+         << setw(7) << "C(HI)" << setw(7) << "R_LO" << setw(7) << "R_HI";
+    for (auto &row : rows) cout << setw(17) << row.name.substr(0, row.name.find(' '));
+    cout << "\n";
+    auto bound = [](int v) { return v == INT_MAX ? string("-") : to_string(v); };
+    for (size_t i = 0; i < tasks.size() && i < 50; ++i) {
+        const MCTask &t = tasks[i];
+        cout << left << setw(8) << t.name << setw(5) << (t.hi ? "HI" : "LO") << right << setw(7) << t.period
+             << setw(7) << t.deadline << setw(7) << t.cLo << setw(7) << t.cHi << setw(7) << bound(rLo[i])
+             << setw(7) << (t.hi ? bound(rHi[i]) : string(""));
+        for (auto &r : results) cout << setw(17) << r.worstResponse[i];
+        cout << "\n";
+    }
+    if (tasks.size() > 50) cout << "(" << tasks.size() - 50 << " more tasks not shown)\n";
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Fluid processor sharing (PS / GPS)
+// ---------------------------------------------------------------------------
+// Every active job is served at once, job i at rate w_i / W where W is the total
+// active weight. Virtual time V advances at rate 1 / W, so a job arriving at V
+// finishes when V reaches V + burst / w_i, and jobs leave in order of that tag
+// whatever arrives later. Each arrival or departure costs O(log n). This is the
+// limit Round Robin approaches as the quantum shrinks (and context switches are free).
+
+// CFS-style weight: each priority level above the best one gets 1/1.25 of the share
+double priorityWeight(int priority, int minPriority) {
+    return pow(1.25, -min(200, max(0, priority - minPriority)));
+}
+
+// Fluid completion times, indexed like procs (weighted = GPS, else egalitarian PS)
+vector<double> simulateFluid(const vector<Process> &procs, bool weighted) {
+    int n = (int)procs.size();
+    vector<double> completion(n, 0), weight(n, 1.0);
+    if (weighted && n > 0) {
+        int minPriority = INT_MAX;
+        for (auto &p : procs) minPriority = min(minPriority, p.priority);
+        for (int i = 0; i < n; ++i) weight[i] = priorityWeight(procs[i].priority, minPriority);
+    }
+    vector<int> byArrival(n);
+    iota(byArrival.begin(), byArrival.end(), 0);
+    stable_sort(byArrival.begin(), byArrival.end(), [&](int a, int b){ return procs[a].arrival < procs[b].arrival; });
+
+    using Tag = pair<double, int>; // virtual finish time, index
+    priority_queue<Tag, vector<Tag>, greater<Tag>> active;
+    double now = 0, virt = 0, totalWeight = 0;
+    size_t next = 0;
+    while (next < byArrival.size() || !active.empty()) {
+        double departure = active.empty() ? numeric_limits<double>::infinity()
+                                          : now + (active.top().first - virt) * totalWeight;
+        if (next < byArrival.size() && procs[byArrival[next]].arrival <= departure) {
+            int i = byArrival[next++];
+            if (totalWeight > 0) virt += (procs[i].arrival - now) / totalWeight;
+            now = max(now, (double)procs[i].arrival);
+            active.push({virt + procs[i].burst / weight[i], i});
+            totalWeight += weight[i];
+        } else {
+            auto [tag, i] = active.top();
+            active.pop();
+            now = departure;
+            virt = tag;
+            completion[i] = now;
+            totalWeight = active.empty() ? 0 : totalWeight - weight[i];
+        }
+    }
+    return completion;
+}
+
+struct FluidRow {
+    double avgWaiting = 0, avgTurnaround = 0, avgSlowdown = 0, maxTurnaround = 0;
+};
+
+FluidRow fluidRow(const vector<Process> &procs, const function<double(int)> &completion) {
+    FluidRow r;
+    int n = max(1, (int)procs.size());
+    for (int i = 0; i < (int)procs.size(); ++i) {
+        double tat = completion(i) - procs[i].arrival;
+        r.avgTurnaround += tat / n;
+        r.avgWaiting += (tat - procs[i].burst) / n;
+        r.avgSlowdown += tat / max(1, procs[i].burst) / n;
+        r.maxTurnaround = max(r.maxTurnaround, tat);
+    }
+    return r;
+}
+
+// PS and GPS next to a Round Robin quantum sweep (and Preemptive Priority for GPS)
+void runProcessorSharingReference(const vector<Process> &base) {
+    cout << "=== Processor Sharing Reference ===\n";
+    auto t0 = chrono::steady_clock::now();
+    vector<double> ps = simulateFluid(base, false);
+    auto t1 = chrono::steady_clock::now();
+    vector<double> gps = simulateFluid(base, true);
+    FluidRow psRow = fluidRow(base, [&](int i){ return ps[i]; });
+    cout << "Fluid simulation of " << base.size() << " jobs: " << fixed << setprecision(1)
+         << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+
+    cout << left << setw(24) << "Policy" << right << setw(11) << "AvgWT" << setw(11) << "AvgTAT" << setw(10)
+         << "Slowdown" << setw(11) << "MaxTAT" << setw(12) << "Switches" << setw(11) << "TAT vs PS" << "\n";
+    auto row = [&](const string &name, const FluidRow &r, const string &switches) {
+        cout << left << setw(24) << name << right << fixed << setprecision(3) << setw(11) << r.avgWaiting
+             << setw(11) << r.avgTurnaround << setw(10) << r.avgSlowdown << setw(11) << setprecision(1)
+             << r.maxTurnaround << setw(12) << switches << setw(10) << setprecision(2)
+             << (psRow.avgTurnaround > 0 ? r.avgTurnaround / psRow.avgTurnaround : 1.0) << "x\n";
+    };
+    row("PS (fluid)", psRow, "-");
+    row("GPS (1.25^-priority)", fluidRow(base, [&](int i){ return gps[i]; }), "-");
+    auto discrete = [&](int choice, int tq) {
+        auto procs = base;
+        Metrics m = runPolicyMetrics(choice, procs, tq);
+        row(policyName(choice, tq), fluidRow(procs, [&](int i){ return (double)procs[i].completion; }),
+            to_string(m.contextSwitches));
+    };
+    for (int tq : {1, 2, 4, 8, 16, 32, 64}) discrete(4, tq);
+    discrete(3, 1);
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// EEVDF pick benchmark
+// ---------------------------------------------------------------------------
+// n CPU-bound entities are runnable at once; every decision picks the eligible
+// entity with the earliest deadline, charges it one slice and re-queues it, as
+// simulateEEVDF does. The O(n) scan over plain arrays is the baseline.
+
+void runEEVDFBenchmark(int slice) {
+    cout << "=== EEVDF Pick Benchmark (slice " << slice << ") ===\n";
+    cout << right << setw(10) << "Runnable" << setw(14) << "Tree ns/pick" << setw(14) << "Scan ns/pick"
+         << setw(10) << "Speedup" << setw(12) << "Max lag" << "\n";
+    for (int n : {1000, 10000, 100000, 1000000, 2000000}) {
+        mt19937 rng(n);
+        vector<int> weight(n);
+        for (auto &w : weight) w = niceWeights[rng() % 20];
+        vector<long long> v(n, 0), vd(n);
+        for (int i = 0; i < n; ++i) vd[i] = (long long)slice * EEVDFScale / weight[i];
+        __int128 sum = 0;
+        long long total = 0;
+        for (int i = 0; i < n; ++i) total += weight[i];
+
+        EligibilityTree tree;
+        tree.reset(n);
+        for (int i = 0; i < n; ++i) tree.insert(i, v[i], vd[i]);
+        const int decisions = 1000000;
+        double maxLag = 0;
+        auto t0 = chrono::steady_clock::now();
+        for (int d = 0; d < decisions; ++d) {
+            int i = tree.pickEligible(sum, total);
+            maxLag = max(maxLag, (double)((long double)sum / total - v[i]) * weight[i] / EEVDFScale);
+            tree.erase(i);
+            long long step = (long long)slice * EEVDFScale / weight[i];
+            v[i] += step;
+            vd[i] = v[i] + step;
+            sum += (__int128)weight[i] * step;
+            tree.insert(i, v[i], vd[i]);
+        }
+        auto t1 = chrono::steady_clock::now();
+        double treeNs = chrono::duration<double, nano>(t1 - t0).count() / decisions;
+
+        // same decision sequence with a linear scan, fewer decisions for large n
+        fill(v.begin(), v.end(), 0);
+        for (int i = 0; i < n; ++i) vd[i] = (long long)slice * EEVDFScale / weight[i];
+        sum = 0;
+        int scanDecisions = max(20, (int)(200000000LL / n));
+        t0 = chrono::steady_clock::now();
+        for (int d = 0; d < scanDecisions; ++d) {
+            int best = -1;
+            for (int i = 0; i < n; ++i)
+                if ((__int128)v[i] * total <= sum && (best < 0 || vd[i] < vd[best])) best = i;
+            long long step = (long long)slice * EEVDFScale / weight[best];
+            v[best] += step;
+            vd[best] = v[best] + step;
+            sum += (__int128)weight[best] * step;
+        }
+        t1 = chrono::steady_clock::now();
+        double scanNs = chrono::duration<double, nano>(t1 - t0).count() / scanDecisions;
+        cout << setw(10) << n << fixed << setprecision(1) << setw(14) << treeNs << setw(14) << scanNs
+             << setw(9) << scanNs / treeNs << "x" << setw(12) << setprecision(2) << maxLag << "\n";
+    }
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Size-based policies for unknown job sizes
+// ---------------------------------------------------------------------------
+// Each job has a rank that depends only on its own attained service (age), so
+// waiting jobs keep their ranks and only the running job's rank moves. Waiting
+// jobs sit in a binary heap; the running job is re-compared with the top only
+// at arrivals, completions and the instants its rank can overtake the top:
+//   FB/LAS      rank = age (least attained service first)
+//   Gittins     rank of the Gittins index of the size distribution at the
+//               job's age bucket (higher index first), from a precomputed table
+//   SRPT-noisy  rank = estimate - age, with a multiplicative log-normal error
+
+enum class SizePolicy { Gittins, LAS, NoisySRPT };
+
+// Gittins index per age bucket: for a job of age a,
+//   G(a) = max over D of P(S <= a + D | S > a) / E[min(S - a, D) | S > a],
+// with a + D taken from the bucket bounds. Buckets are single ages up to 256,
+// then geometric; ranks order the buckets by decreasing index.
+struct GittinsTable {
+    vector<int> bounds;     // bucket k covers ages [bounds[k], bounds[k + 1])
+    vector<double> index;
+    vector<long long> rank;
+
+    int bucketOf(int age) const {
+        return (int)(upper_bound(bounds.begin(), bounds.end(), age) - bounds.begin()) - 1;
+    }
+};
+
+GittinsTable buildGittinsTable(vector<int> sizes, int maxBuckets = 2048) {
+    GittinsTable t;
+    sort(sizes.begin(), sizes.end());
+    int maxSize = sizes.empty() ? 1 : max(1, sizes.back());
+    for (int a = 0; a <= min(maxSize, 256); ++a) t.bounds.push_back(a);
+    if (maxSize > 256) {
+        double ratio = pow((double)maxSize / 256, 1.0 / max(1, maxBuckets - 257));
+        for (double b = 256 * ratio; t.bounds.back() < maxSize; b *= ratio)
+            t.bounds.push_back(max(t.bounds.back() + 1, min(maxSize, (int)llround(b))));
+    }
+    t.bounds.push_back(maxSize + 1);
+    int B = (int)t.bounds.size() - 1;
+    // sizes completed by the end of each bound
+    vector<long long> cnt(B + 1, 0), sum(B + 1, 0);
+    for (int k = 0; k <= B; ++k) {
+        size_t c = upper_bound(sizes.begin(), sizes.end(), t.bounds[k]) - sizes.begin();
+        cnt[k] = (long long)c;
+        sum[k] = k ? sum[k - 1] : 0;
+        for (size_t j = k ? (size_t)cnt[k - 1] : 0; j < c; ++j) sum[k] += sizes[j];
+    }
+    long long N = (long long)sizes.size();
+    t.index.assign(B, 0);
+    for (int k = 0; k < B; ++k) {
+        long long a = t.bounds[k];
+        long long alive = N - cnt[k];
+        if (alive <= 0) continue;
+        for (int m = k + 1; m <= B; ++m) {
+            long long done = cnt[m] - cnt[k];
+            double work = (double)(sum[m] - sum[k]) - (double)a * done + (double)(t.bounds[m] - a) * (N - cnt[m]);
+            if (work > 0) t.index[k] = max(t.index[k], done / work);
+        }
+    }
+    vector<double> sorted(t.index);
+    sort(sorted.begin(), sorted.end(), greater<double>());
+    sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+    t.rank.resize(B);
+    for (int k = 0; k < B; ++k)
+        t.rank[k] = lower_bound(sorted.begin(), sorted.end(), t.index[k], greater<double>()) - sorted.begin();
+    return t;
+}
+
+// Size estimates: burst * exp(sigma * N(0, 1)), at least 1, reproducible per seed
+vector<int> noisyEstimates(const vector<Process> &procs, double sigma, unsigned seed) {
+    mt19937 rng(seed);
+    normal_distribution<double> noise(0.0, sigma);
+    vector<int> est(procs.size());
+    for (size_t i = 0; i < procs.size(); ++i)
+        est[i] = (int)max(1.0, min(1e9, round(procs[i].burst * exp(noise(rng)))));
+    return est;
+}
+
+Schedule simulateSizeBased(vector<Process> &procs, SizePolicy policy, const GittinsTable *table = nullptr,
+                           const vector<int> *estimates = nullptr) {
+    resetProcesses(procs);
+    int n = (int)procs.size();
+    vector<int> byArrival(n);
+    iota(byArrival.begin(), byArrival.end(), 0);
+    stable_sort(byArrival.begin(), byArrival.end(), [&](int a, int b){ return procs[a].arrival < procs[b].arrival; });
+    auto age = [&](int i) { return procs[i].burst - procs[i].remaining; };
+    auto key = [&](int i) -> long long {
+        switch (policy) {
+            case SizePolicy::LAS: return age(i);
+            case SizePolicy::Gittins: return table->rank[table->bucketOf(age(i))];
+            case SizePolicy::NoisySRPT: return (long long)(*estimates)[i] - age(i);
+        }
+        return 0;
+    };
+    BinaryHeapRQ rq;
+    rq.reset(n);
+    size_t next = 0;
+    auto admit = [&](int t) {
+        while (next < byArrival.size() && procs[byArrival[next]].arrival <= t) {
+            int i = byArrival[next++];
+            rq.insert(i, key(i));
+        }
+    };
+    Schedule out;
+    auto emit = [&](int pid, int s, int e) {
+        if (e <= s) return;
+        if (!out.empty() && out.back().pid == pid && out.back().end == s) out.back().end = e;
+        else out.push_back({pid, s, e});
+    };
+    auto dispatch = [&](int i, int now) {
+        Process &p = procs[i];
+        if (p.start == -1) p.start = now, p.response = now - p.arrival;
+    };
+
+    int now = 0, completed = 0, running = -1, sliceStart = 0;
+    while (completed < n) {
+        admit(now);
+        if (running < 0) {
+            if (rq.empty()) { now = max(now, procs[byArrival[next]].arrival); continue; }
+            running = rq.extractMin();
+            dispatch(running, now);
+            sliceStart = now;
+        }
+        Process &p = procs[running];
+        int end = now + p.remaining;
+        if (next < byArrival.size()) end = min(end, procs[byArrival[next]].arrival);
+        // the next instant the running job's rank can pass the top of the queue
+        if (policy == SizePolicy::LAS && !rq.empty()) {
+            int top = rq.heap[0];
+            long long gap = rq.key[top] - age(running) + (running < top ? 1 : 0);
+            end = (int)min<long long>(end, now + max(1LL, gap));
+        } else if (policy == SizePolicy::Gittins) {
+            int k = table->bucketOf(age(running));
+            if (k + 1 < (int)table->bounds.size()) end = min(end, now + table->bounds[k + 1] - age(running));
+        }
+        p.remaining -= end - now;
+        now = end;
+        if (p.remaining == 0) {
+            p.completion = now;
+            completed++;
+            emit(p.pid, sliceStart, now);
+            running = -1;
+            continue;
+        }
+        admit(now);
+        rq.insert(running, key(running));
+        int best = rq.extractMin();
+        if (best != running) {
+            emit(p.pid, sliceStart, now);
+            running = best;
+            dispatch(running, now);
+            sliceStart = now;
+        }
+    }
+    return out;
+}
+
+// Poisson arrivals at the given load with bounded-Pareto sizes (alpha 1.1, 1..1000)
+vector<Process> generateHeavyTailedWorkload(int n, double load, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    const double alpha = 1.1, lo = 1, hi = 1000;
+    vector<Process> procs(n);
+    double total = 0;
+    for (int i = 0; i < n; ++i) {
+        double u = unit(rng);
+        double x = lo / pow(1 - u * (1 - pow(lo / hi, alpha)), 1 / alpha);
+        procs[i].pid = i + 1;
+        procs[i].burst = (int)min(hi, max(lo, round(x)));
+        procs[i].remaining = procs[i].burst;
+        total += procs[i].burst;
+    }
+    exponential_distribution<double> gap(load / (total / max(1, n)));
+    double t = 0;
+    for (auto &p : procs) { p.arrival = (int)t; t += gap(rng); }
+    return procs;
+}
+
+void runSizeBasedComparison(const vector<Process> &loaded, int tq) {
+    cout << "=== Size-Based Policies for Unknown Job Sizes ===\n";
+    vector<pair<string, vector<Process>>> workloads = {
+        {"Loaded workload", loaded},
+        {"Heavy-tailed sizes (bounded Pareto, load 0.8)",
+         generateHeavyTailedWorkload(max(2000, (int)loaded.size()), 0.8, 17)},
+    };
+    for (auto &[title, base] : workloads) {
+        vector<int> sizes;
+        for (auto &p : base) sizes.push_back(p.burst);
+        GittinsTable table = buildGittinsTable(sizes);
+        cout << title << " (n=" << base.size() << ", " << table.index.size() << " Gittins age buckets):\n";
+        cout << left << setw(28) << "Policy" << right << setw(11) << "AvgTAT" << setw(10) << "Slowdown"
+             << setw(10) << "MaxTAT" << setw(11) << "Switches" << "\n";
+        auto row = [&](const string &name, vector<Process> &procs, const Schedule &s) {
+            Metrics m = computeMetrics(procs, s);
+            FluidRow r = fluidRow(procs, [&](int i){ return (double)procs[i].completion; });
+            cout << left << setw(28) << name << right << fixed << setprecision(3) << setw(11) << r.avgTurnaround
+                 << setw(10) << r.avgSlowdown << setw(10) << setprecision(0) << r.maxTurnaround
+                 << setw(11) << m.contextSwitches << "\n";
+        };
+        auto known = [&](int choice) {
+            auto procs = base;
+            Schedule s = runPolicySchedule(choice, procs, tq, true);
+            row(policyName(choice, tq) + (choice == 2 ? " (exact)" : ""), procs, s);
+        };
+        known(2);
+        for (double sigma : {0.5, 1.0, 2.0}) {
+            auto procs = base;
+            vector<int> est = noisyEstimates(procs, sigma, 99);
+            Schedule s = simulateSizeBased(procs, SizePolicy::NoisySRPT, nullptr, &est);
+            ostringstream name;
+            name << "SRPT, noisy (sigma=" << setprecision(1) << fixed << sigma << ")";
+            row(name.str(), procs, s);
+        }
+        {
+            auto procs = base;
+            Schedule s = simulateSizeBased(procs, SizePolicy::Gittins, &table);
+            row("Gittins index", procs, s);
+        }
+        {
+            auto procs = base;
+            Schedule s = simulateSizeBased(procs, SizePolicy::LAS);
+            row("FB / LAS", procs, s);
+        }
+        known(4);
+        known(1);
+    }
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Closed-loop clients
+// ---------------------------------------------------------------------------
+// A fixed population of clients, each with one request outstanding: a client
+// submits, waits for its request to complete, thinks for an exponential time and
+// submits again. A client's request uses the client index as its ready-queue id
+// and the engine's keys; the next submissions sit in a min-heap of wake times.
+// Request sizes and priorities are drawn from the workload's rows.
+
+struct ClosedLoopPoint {
+    int clients = 0;
+    double throughput = 0, response = 0, utilization = 0;
+};
+
+ClosedLoopPoint simulateClosedLoop(const vector<Process> &base, int choice, int tq, int clients, double thinkMean,
+                                   long long jobs, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<size_t> pick(0, base.size() - 1);
+    exponential_distribution<double> think(1.0 / max(thinkMean, 1e-9));
+    struct Request { int remaining = 0, priority = 0; long long submit = 0; };
+    vector<Request> req(clients);
+
+    DaryHeapRQ<4> rq;
+    rq.reset(clients);
+    long long seq = 0;
+    auto key = [&](int i) {
+        if (choice == 2) return rqKey(req[i].remaining, 0);
+        if (choice == 3) return rqKey(req[i].priority, req[i].remaining);
+        return seq++;
+    };
+    bool preemptive = (choice == 2 || choice == 3);
+    using Wake = pair<long long, int>;
+    priority_queue<Wake, vector<Wake>, greater<Wake>> wakes;
+    auto sleep = [&](int i, long long now) { wakes.push({now + (long long)llround(thinkMean > 0 ? think(rng) : 0), i}); };
+    auto admit = [&](long long now) {
+        while (!wakes.empty() && wakes.top().first <= now) {
+            auto [submit, i] = wakes.top();
+            wakes.pop();
+            const Process &p = base[pick(rng)];
+            req[i] = {p.burst, p.priority, submit};
+            rq.insert(i, key(i));
+        }
+    };
+    for (int i = 0; i < clients; ++i) sleep(i, 0);
+
+    // the first tenth of the completions is warm-up
+    long long warmup = jobs / 10, done = 0, measured = 0, busy = 0, windowStart = 0;
+    double responseSum = 0;
+    long long now = 0;
+    int running = -1, lastOnCPU = -1;
+    while (done < warmup + jobs) {
+        admit(now);
+        if (running < 0) {
+            if (rq.empty()) { now = max(now, wakes.top().first); continue; }
+            running = rq.extractMin();
+            if (contextSwitchCost > 0 && lastOnCPU >= 0 && lastOnCPU != running) now += contextSwitchCost;
+            lastOnCPU = running;
+        }
+        Request &r = req[running];
+        long long end = now + (choice == 4 ? min(tq, r.remaining) : r.remaining);
+        if (preemptive && !wakes.empty()) end = max(now, min(end, wakes.top().first));
+        r.remaining -= (int)(end - now);
+        if (done >= warmup) busy += end - now;
+        now = end;
+        if (r.remaining == 0) {
+            if (++done == warmup) windowStart = now;
+            else if (done > warmup) measured++, responseSum += now - r.submit;
+            sleep(running, now);
+            running = -1;
+            continue;
+        }
+        admit(now);
+        if (choice == 4) {
+            rq.insert(running, key(running));
+            running = -1;
+        } else if (preemptive && !rq.empty()) {
+            rq.insert(running, key(running));
+            running = rq.extractMin();
+            if (contextSwitchCost > 0 && lastOnCPU != running) now += contextSwitchCost;
+            lastOnCPU = running;
+        }
+    }
+    ClosedLoopPoint pt;
+    pt.clients = clients;
+    double window = max<long long>(1, now - windowStart);
+    pt.throughput = measured / window;
+    pt.response = measured ? responseSum / measured : 0;
+    pt.utilization = busy / window;
+    return pt;
+}
+
+// Throughput X(N) and response time R(N) against the population N. Asymptotic
+// bounds: X(N) <= min(N / (D + Z), 1 / D) with mean demand D and think time Z,
+// which meet at the saturation population N* = (D + Z) / D. R(N) averages the
+// completed requests, so it hides requests SRTF or Priority starve in a window.
+void runClosedLoop(const vector<Process> &base, int tq, double thinkMean, int maxClients, long long jobs) {
+    cout << "=== Closed-Loop Clients (mean think time " << fixed << setprecision(1) << thinkMean << ") ===\n";
+    double demand = 0;
+    for (auto &p : base) demand += (double)p.burst / base.size();
+    double saturation = (demand + thinkMean) / demand;
+    if (maxClients <= 0) maxClients = max(4, (int)ceil(4 * saturation));
+    cout << "Mean demand D=" << setprecision(3) << demand << ", saturation population N*=(D+Z)/D="
+         << setprecision(2) << saturation << ", max throughput 1/D=" << setprecision(4) << 1 / demand << "\n";
+    vector<int> populations;
+    for (int c = 1; c < maxClients; c *= 2) populations.push_back(c);
+    for (int c : {(int)floor(saturation), (int)ceil(saturation)})
+        if (c >= 1 && c < maxClients) populations.push_back(c);
+    populations.push_back(maxClients);
+    sort(populations.begin(), populations.end());
+    populations.erase(unique(populations.begin(), populations.end()), populations.end());
+
+    for (int choice : {1, 2, 3, 4}) {
+        cout << policyName(choice, tq) << ":\n";
+        cout << right << setw(9) << "Clients" << setw(13) << "X(N)" << setw(11) << "X bound" << setw(12) << "R(N)"
+             << setw(8) << "Util" << "\n";
+        int knee = -1;
+        for (int c : populations) {
+            ClosedLoopPoint pt = simulateClosedLoop(base, choice, tq, c, thinkMean, jobs, 1000 + c);
+            double bound = min(c / (demand + thinkMean), 1 / demand);
+            if (knee < 0 && pt.throughput >= 0.95 / demand) knee = c;
+            cout << setw(9) << c << setw(13) << setprecision(5) << pt.throughput << setw(11) << bound << setw(12)
+                 << setprecision(2) << pt.response << setw(7) << setprecision(1) << 100 * pt.utilization << "%\n";
+        }
+        if (knee > 0) cout << "Throughput within 5% of 1/D from N=" << knee << "\n";
+        else cout << "Throughput stays below 95% of 1/D up to N=" << populations.back() << "\n";
+    }
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Timeouts, abandonment and retries
+// ---------------------------------------------------------------------------
+// Every attempt carries a client timeout. An attempt still waiting when it
+// expires abandons the ready queue (an O(log n) heap removal); one already on
+// the CPU keeps running, as the server does not learn of the timeout, and its
+// work is wasted. Timed-out requests retry after a backoff until they run out
+// of attempts. Attempts are queue ids, sized for the worst case up front.
+
+enum class RetryBackoff { Immediate = 1, Exponential, Jittered };
+
+struct RetryConfig {
+    int timeout = 100;
+    int attempts = 3;  // per request, including the first
+    RetryBackoff backoff = RetryBackoff::Exponential;
+    int base = 10;     // backoff before retry k is base * 2^(k-1), jittered uniformly in [0, that]
+};
+
+struct OverloadResult {
+    double amplification = 0, success = 0, goodput = 0, abandoned = 0, wasted = 0, effectiveLoad = 0;
+};
+
+// Poisson arrivals at the given load with sizes and priorities resampled from the workload
+vector<Process> resampleAtLoad(const vector<Process> &base, int n, double load, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<size_t> pick(0, base.size() - 1);
+    double mean = 0;
+    for (auto &p : base) mean += (double)p.burst / base.size();
+    exponential_distribution<double> gap(load / mean);
+    vector<Process> procs(n);
+    double t = 0;
+    for (int i = 0; i < n; ++i) {
+        procs[i] = base[pick(rng)];
+        procs[i].pid = i + 1;
+        procs[i].arrival = (int)t;
+        procs[i].remaining = procs[i].burst;
+        t += gap(rng);
+    }
+    return procs;
+}
+
+OverloadResult simulateWithRetries(const vector<Process> &requests, int choice, int tq, const RetryConfig &cfg,
+                                   unsigned seed) {
+    struct Attempt { int request, number, remaining, served = 0; bool queued = true, over = false, answered = false; };
+    mt19937 rng(seed);
+    int n = (int)requests.size();
+    vector<Attempt> att;
+    att.reserve((size_t)n * cfg.attempts);
+    vector<char> succeeded(n, 0);
+
+    DaryHeapRQ<4> rq;
+    rq.reset(n * cfg.attempts);
+    long long seq = 0;
+    auto key = [&](int a) {
+        if (choice == 2) return rqKey(att[a].remaining, 0);
+        if (choice == 3) return rqKey(requests[att[a].request].priority, att[a].remaining);
+        return seq++;
+    };
+    bool preemptive = (choice == 2 || choice == 3);
+    using Event = pair<long long, int>;
+    priority_queue<Event, vector<Event>, greater<Event>> retries, timeouts;
+    size_t next = 0;  // requests arrive in order
+    auto submit = [&](int r, int number, long long t) {
+        int a = (int)att.size();
+        att.push_back({r, number, requests[r].burst});
+        rq.insert(a, key(a));
+        timeouts.push({t + cfg.timeout, a});
+    };
+    auto nextArrival = [&]() {
+        long long t = LLONG_MAX;
+        if (next < requests.size()) t = requests[next].arrival;
+        if (!retries.empty()) t = min(t, retries.top().first);
+        return t;
+    };
+    long long abandoned = 0;
+    // arrivals and timeouts due by `now`, in time order
+    auto settle = [&](long long now) {
+        while (true) {
+            long long ta = nextArrival(), tt = timeouts.empty() ? LLONG_MAX : timeouts.top().first;
+            if (min(ta, tt) > now) return;
+            if (tt <= ta) {
+                int a = timeouts.top().second;
+                timeouts.pop();
+                Attempt &x = att[a];
+                if (x.over || x.remaining == 0) continue;
+                x.over = true;
+                if (x.queued) { rq.remove(a); x.queued = false; abandoned++; }
+                if (x.number < cfg.attempts) {
+                    long long delay = 0;
+                    if (cfg.backoff != RetryBackoff::Immediate) {
+                        delay = (long long)cfg.base << min(x.number - 1, 30);
+                        if (cfg.backoff == RetryBackoff::Jittered) delay = uniform_int_distribution<long long>(0, delay)(rng);
+                    }
+                    retries.push({tt + delay, x.request * cfg.attempts + x.number});
+                }
+            } else if (!retries.empty() && retries.top().first == ta) {
+                auto [t, code] = retries.top();
+                retries.pop();
+                submit(code / cfg.attempts, code % cfg.attempts + 1, t);
+            } else {
+                submit((int)next, 1, ta);
+                next++;
+            }
+        }
+    };
+
+    long long now = 0, sliceEnd = 0;
+    int running = -1, lastOnCPU = -1;
+    auto dispatch = [&](int a) {
+        att[a].queued = false;
+        if (contextSwitchCost > 0 && lastOnCPU >= 0 && lastOnCPU != a) now += contextSwitchCost;
+        lastOnCPU = a;
+        sliceEnd = choice == 4 ? now + tq : LLONG_MAX;
+    };
+    while (true) {
+        settle(now);
+        if (running < 0) {
+            if (rq.empty()) {
+                long long t = min(nextArrival(), timeouts.empty() ? LLONG_MAX : timeouts.top().first);
+                if (t == LLONG_MAX) break;
+                now = max(now, t);
+                continue;
+            }
+            running = rq.extractMin();
+            dispatch(running);
+        }
+        Attempt &x = att[running];
+        long long end = min(now + x.remaining, sliceEnd);
+        end = min(end, max(now, min(nextArrival(), timeouts.empty() ? LLONG_MAX : timeouts.top().first)));
+        x.remaining -= (int)(end - now);
+        x.served += (int)(end - now);
+        now = end;
+        if (x.remaining == 0) {
+            if (!x.over) succeeded[x.request] = 1, x.answered = x.over = true;
+            running = -1;
+            continue;
+        }
+        settle(now);
+        if (choice == 4 && now >= sliceEnd) {
+            x.queued = true;
+            rq.insert(running, key(running));
+            running = -1;
+        } else if (preemptive && !rq.empty()) {
+            rq.insert(running, key(running));
+            int best = rq.extractMin();
+            if (best != running) {
+                att[running].queued = true;
+                running = best;
+                dispatch(running);
+            }
+        }
+    }
+
+    OverloadResult r;
+    long long useful = 0, wasted = 0, offered = 0;
+    for (auto &x : att) {
+        (x.answered ? useful : wasted) += x.served;
+        offered += requests[x.request].burst;
+    }
+    long long span = max<long long>(1, now);
+    int ok = (int)count(succeeded.begin(), succeeded.end(), 1);
+    r.amplification = (double)att.size() / max(1, n);
+    r.success = 100.0 * ok / max(1, n);
+    r.goodput = (double)useful / span;
+    r.abandoned = 100.0 * abandoned / max<size_t>(1, att.size());
+    r.wasted = 100.0 * wasted / span;
+    r.effectiveLoad = (double)offered / max(1, requests.back().arrival);
+    return r;
+}
+
+// Goodput and retry amplification against offered load, per policy
+void runRetryStorm(const vector<Process> &base, int tq, const RetryConfig &cfg) {
+    static const char *backoffNames[] = {"", "immediate", "exponential", "exponential with jitter"};
+    cout << "=== Timeouts and Retries (timeout " << cfg.timeout << ", " << cfg.attempts << " attempts, "
+         << backoffNames[(int)cfg.backoff] << " backoff";
+    if (cfg.backoff != RetryBackoff::Immediate) cout << ", base " << cfg.base;
+    cout << ") ===\n";
+    int n = max(5000, (int)base.size());
+    for (int choice : {1, 2, 3, 4}) {
+        cout << policyName(choice, tq) << ":\n";
+        cout << right << setw(8) << "Load" << setw(11) << "With retry" << setw(10) << "Attempts" << setw(10)
+             << "Success" << setw(10) << "Goodput" << setw(11) << "Abandoned" << setw(9) << "Wasted" << "\n";
+        for (double load : {0.5, 0.7, 0.9, 1.0, 1.2, 1.5, 2.0}) {
+            vector<Process> requests = resampleAtLoad(base, n, load, 31);
+            OverloadResult r = simulateWithRetries(requests, choice, tq, cfg, 7);
+            cout << setw(8) << fixed << setprecision(2) << load << setw(11) << r.effectiveLoad << setw(9)
+                 << setprecision(2) << r.amplification << "x" << setw(9) << setprecision(1) << r.success << "%"
+                 << setw(10) << setprecision(3) << r.goodput << setw(10) << setprecision(1) << r.abandoned << "%"
+                 << setw(8) << r.wasted << "%\n";
+        }
+    }
+    cout << "Success: requests answered within the timeout. Goodput: CPU share spent on those answers.\n"
+         << "Abandoned: attempts that left the queue. Wasted: CPU share spent on attempts whose client gave up.\n\n";
+}
+
+// ---------------------------------------------------------------------------
+// Constant Bandwidth Server reservations
+// ---------------------------------------------------------------------------
+// Each reservation is a CBS server with budget Q every period T serving its jobs
+// in arrival order. Backlogged servers with budget run under EDF on their server
+// deadline; jobs outside any reservation run FCFS in the background. When a
+// server wakes up with more budget than its bandwidth allows before the current
+// deadline (c > (d - t) Q / T) it gets a fresh deadline t + T and a full budget.
+// An exhausted budget is an overrun: a hard reservation is throttled until its
+// deadline and then replenished, a soft one is replenished at once with its
+// deadline pushed back by T. Server ids index the EDF heap and the throttle heap.
+
+struct Reservation {
+    int budget = 1, period = 1;
+    bool hard = true;
+};
+map<string, Reservation> classReservations;  // --reservation flags, by request class
+
+// Parse --reservation=<class>:<budget>/<period>[:hard|soft]
+bool parseReservationFlag(const string &spec) {
+    vector<string> parts;
+    stringstream ss(spec);
+    string part;
+    while (getline(ss, part, ':')) parts.push_back(part);
+    if (parts.size() < 2 || parts.size() > 3 || parts[0].empty()) return false;
+    Reservation r;
+    if (sscanf(parts[1].c_str(), "%d/%d", &r.budget, &r.period) != 2) return false;
+    if (parts.size() == 3) {
+        if (parts[2] != "hard" && parts[2] != "soft") return false;
+        r.hard = parts[2] == "hard";
+    }
+    if (r.budget <= 0 || r.period <= 0 || r.budget > r.period) return false;
+    classReservations[parts[0]] = r;
+    return true;
+}
+
+struct ServerStats {
+    long long jobs = 0, overruns = 0, throttled = 0;
+    double sumLatency = 0;
+    LogHistogram latency;
+};
+
+// serverOf[i] is the reservation serving process i, or -1 for background work.
+// Fills completion times and returns per-server statistics.
+vector<ServerStats> simulateCBS(vector<Process> &procs, const vector<int> &serverOf, const vector<Reservation> &rsv) {
+    resetProcesses(procs);
+    int n = (int)procs.size(), S = (int)rsv.size();
+    vector<int> byArrival(n);
+    iota(byArrival.begin(), byArrival.end(), 0);
+    stable_sort(byArrival.begin(), byArrival.end(), [&](int a, int b){ return procs[a].arrival < procs[b].arrival; });
+
+    struct Server { long long budget = 0, deadline = 0, throttledSince = 0; deque<int> jobs; bool throttled = false; };
+    vector<Server> srv(S);
+    vector<ServerStats> stats(S);
+    DaryHeapRQ<4> edf;  // backlogged servers with budget, keyed by deadline
+    edf.reset(S);
+    using Wake = pair<long long, int>;
+    priority_queue<Wake, vector<Wake>, greater<Wake>> replenish;
+    deque<int> background;
+
+    size_t next = 0;
+    auto admit = [&](long long now) {
+        while (next < byArrival.size() && procs[byArrival[next]].arrival <= now) {
+            int i = byArrival[next++], s = serverOf[i];
+            if (s < 0) { background.push_back(i); continue; }
+            Server &v = srv[s];
+            v.jobs.push_back(i);
+            if (v.jobs.size() > 1 || v.throttled) continue;
+            // wake-up rule
+            if (v.budget * rsv[s].period >= (v.deadline - now) * rsv[s].budget) {
+                v.deadline = now + rsv[s].period;
+                v.budget = rsv[s].budget;
+            }
+            edf.insert(s, v.deadline);
+        }
+    };
+    auto refill = [&](long long now) {
+        while (!replenish.empty() && replenish.top().first <= now) {
+            int s = replenish.top().second;
+            replenish.pop();
+            Server &v = srv[s];
+            v.throttled = false;
+            stats[s].throttled += now - v.throttledSince;
+            v.budget = rsv[s].budget;
+            v.deadline += rsv[s].period;
+            if (!v.jobs.empty()) edf.insert(s, v.deadline);
+        }
+    };
+    auto start = [&](int i, long long now) {
+        Process &p = procs[i];
+        if (p.start == -1) p.start = (int)now, p.response = p.start - p.arrival, p.queueing = p.response;
+    };
+
+    long long now = 0;
+    int completed = 0;
+    while (completed < n) {
+        refill(now);
+        admit(now);
+        long long horizon = LLONG_MAX;
+        if (next < byArrival.size()) horizon = procs[byArrival[next]].arrival;
+        if (!replenish.empty()) horizon = min(horizon, replenish.top().first);
+        if (edf.empty() && background.empty()) { now = horizon; continue; }
+
+        // EDF picks the server; it stays at the head of the heap while it runs
+        int s = -1, i;
+        if (!edf.empty()) {
+            s = edf.heap[0];
+            i = srv[s].jobs.front();
+        } else {
+            i = background.front();
+        }
+        Process &p = procs[i];
+        start(i, now);
+        long long end = now + p.remaining;
+        if (s >= 0) end = min(end, now + srv[s].budget);
+        end = min(end, horizon);
+        p.remaining -= (int)(end - now);
+        if (s >= 0) srv[s].budget -= end - now;
+        now = end;
+        if (p.remaining == 0) {
+            p.completion = (int)now;
+            p.preempted = p.completion - p.arrival - p.burst - p.queueing;
+            completed++;
+            if (s < 0) background.pop_front();
+            else {
+                srv[s].jobs.pop_front();
+                stats[s].jobs++;
+                stats[s].sumLatency += p.completion - p.arrival;
+                stats[s].latency.add(p.completion - p.arrival);
+                if (srv[s].jobs.empty()) edf.remove(s);
+            }
+        }
+        if (s >= 0 && srv[s].budget == 0) {
+            Server &v = srv[s];
+            if (!v.jobs.empty()) stats[s].overruns++;
+            if (rsv[s].hard) {
+                if (!v.jobs.empty()) edf.remove(s);
+                v.throttled = true;
+                v.throttledSince = now;
+                replenish.push({v.deadline, s});
+            } else {
+                v.budget = rsv[s].budget;
+                v.deadline += rsv[s].period;
+                if (!v.jobs.empty()) { edf.remove(s); edf.insert(s, v.deadline); }
+            }
+        }
+    }
+    return stats;
+}
+
+// UUniFast bandwidths summing to `util`, budgets 2..10 with the period set by
+// the bandwidth, and jobs with exponential sizes (mean one budget) arriving at
+// `demand` times the reserved bandwidth, over 50 median periods. Background jobs
+// add `backgroundLoad`.
+vector<Process> generateReservedWorkload(int servers, double util, double demand, double backgroundLoad,
+                                         unsigned seed, vector<Reservation> &rsv, vector<int> &serverOf) {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    rsv.assign(servers, {});
+    vector<int> periods;
+    double left = util;
+    for (int s = 0; s < servers; ++s) {
+        double u = s + 1 < servers ? left * (1 - pow(unit(rng), 1.0 / (servers - s - 1))) : left;
+        left -= u;
+        int budget = 2 + (int)(unit(rng) * 9);
+        rsv[s] = {budget, (int)min(1e7, max((double)budget, round(budget / max(u, 1e-9)))), true};
+        periods.push_back(rsv[s].period);
+    }
+    nth_element(periods.begin(), periods.begin() + servers / 2, periods.end());
+    int horizon = (int)min(5e8, 50.0 * periods[servers / 2]);
+    vector<Process> procs;
+    serverOf.clear();
+    auto stream = [&](int s, double meanSize, double rate) {
+        exponential_distribution<double> gap(rate), size(1.0 / (meanSize - 0.5));  // rounded up below
+        for (double t = gap(rng); t < horizon; t += gap(rng)) {
+            Process p;
+            p.pid = (int)procs.size() + 1;
+            p.arrival = (int)t;
+            p.burst = max(1, (int)ceil(size(rng)));
+            p.remaining = p.burst;
+            procs.push_back(p);
+            serverOf.push_back(s);
+        }
+    };
+    for (int s = 0; s < servers; ++s) stream(s, rsv[s].budget, demand / rsv[s].period);
+    if (backgroundLoad > 0) stream(-1, 20, backgroundLoad / 20);
+    return procs;
+}
+
+void runReservations(vector<Process> procs, const vector<int> &serverOf, vector<Reservation> rsv,
+                     const vector<string> &names, bool bothModes) {
+    cout << "=== CBS Reservations (" << rsv.size() << " servers, " << procs.size() << " jobs) ===\n";
+    double bandwidth = 0;
+    for (auto &r : rsv) bandwidth += (double)r.budget / r.period;
+    cout << "Reserved bandwidth: " << fixed << setprecision(3) << bandwidth << "\n";
+    vector<int> modes = bothModes ? vector<int>{1, 0} : vector<int>{-1};
+    for (int mode : modes) {
+        if (mode >= 0) for (auto &r : rsv) r.hard = mode == 1;
+        auto t0 = chrono::steady_clock::now();
+        vector<ServerStats> stats = simulateCBS(procs, serverOf, rsv);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        if (mode >= 0) cout << (mode ? "Hard" : "Soft") << " reservations";
+        else cout << "Configured reservations";
+        cout << " (simulated in " << setprecision(1) << ms << " ms):\n";
+
+        // per-reservation rows, worst p99 latency relative to the period first when there are many
+        vector<int> order(rsv.size());
+        iota(order.begin(), order.end(), 0);
+        auto rel = [&](int s) { return (double)stats[s].latency.quantile(0.99) / rsv[s].period; };
+        if (order.size() > 15) {
+            partial_sort(order.begin(), order.begin() + 10, order.end(), [&](int a, int b){ return rel(a) > rel(b); });
+            order.resize(10);
+            cout << "10 reservations with the highest p99 latency / period:\n";
+        }
+        cout << left << setw(14) << "Reservation" << right << setw(11) << "Q/T" << setw(6) << "Mode" << setw(9) << "Jobs"
+             << setw(10) << "Overruns" << setw(11) << "Throttled" << setw(11) << "AvgLat" << setw(9) << "p99Lat"
+             << setw(9) << "MaxLat" << "\n";
+        for (int s : order) {
+            const ServerStats &st = stats[s];
+            ostringstream qt;
+            qt << rsv[s].budget << "/" << rsv[s].period;
+            cout << left << setw(14) << names[s] << right << setw(11) << qt.str() << setw(6)
+                 << (rsv[s].hard ? "hard" : "soft") << setw(9) << st.jobs << setw(10) << st.overruns << setw(11)
+                 << st.throttled << setw(11) << setprecision(2) << (st.jobs ? st.sumLatency / st.jobs : 0.0)
+                 << setw(9) << st.latency.quantile(0.99) << setw(9) << st.latency.quantile(1.0) << "\n";
+        }
+        long long overruns = 0, bgJobs = 0;
+        double bgLatency = 0;
+        for (auto &st : stats) overruns += st.overruns;
+        for (size_t i = 0; i < procs.size(); ++i)
+            if (serverOf[i] < 0) bgJobs++, bgLatency += procs[i].completion - procs[i].arrival;
+        cout << "Total overruns: " << overruns;
+        if (bgJobs) cout << ", background jobs: " << bgJobs << " (avg latency " << setprecision(2) << bgLatency / bgJobs << ")";
+        cout << "\n";
+    }
+    cout << "\n";
+}
+
+// Reservations from --reservation flags on the loaded workload's classes
+void runClassReservations(const vector<Process> &base) {
+    vector<Reservation> rsv;
+    vector<string> names;
+    map<int, int> serverOfClass;
+    for (auto &[name, r] : classReservations) {
+        auto it = find(classNames.begin(), classNames.end(), name);
+        if (it != classNames.end()) serverOfClass[(int)(it - classNames.begin())] = (int)rsv.size();
+        rsv.push_back(r);
+        names.push_back(name);
+    }
+    vector<int> serverOf;
+    for (auto &p : base) {
+        auto it = serverOfClass.find(p.cls);
+        serverOf.push_back(it == serverOfClass.end() ? -1 : it->second);
+    }
+    runReservations(base, serverOf, rsv, names, false);
+}
+
+// ---------------------------------------------------------------------------
+// Adversarial workload search
+// ---------------------------------------------------------------------------
+// Hill climbing with random restarts over bounded workloads, one search per
+// hardware thread, maximizing one metric of one policy. Each thread evaluates
+// candidates on the event engine with its own queue, workspace and buffers, so
+// the search loop does not allocate. The best workload is then shrunk greedily
+// (drop processes, then lower bursts, arrivals and priorities) while the metric
+// stays at the value found, and written as a CSV reproducer.
+
+enum class AdversaryMetric { MaxWaiting = 1, ContextSwitches, P99Response };
+
+struct SearchBounds {
+    int processes = 8, latestArrival = 30, largestBurst = 20, priorityLevels = 5;
+};
+
+class AdversaryEvaluator {
+public:
+    AdversaryEvaluator(int choice, int tq, AdversaryMetric metric) : choice_(choice), tq_(tq), metric_(metric) {}
+
+    long long operator()(const vector<Process> &candidate) {
+        if (candidate.empty()) return 0;
+        work_ = candidate;
+        runEventEngine(work_, choice_, tq_, rq_, ws_, out_);
+        long long worst = 0;
+        switch (metric_) {
+            case AdversaryMetric::MaxWaiting:
+                for (auto &p : work_) worst = max<long long>(worst, p.completion - p.arrival - p.burst);
+                return worst;
+            case AdversaryMetric::ContextSwitches:
+                return countContextSwitches(out_);
+            case AdversaryMetric::P99Response: {
+                responses_.clear();
+                for (auto &p : work_) responses_.push_back(p.response);
+                size_t k = (size_t)ceil(0.99 * responses_.size()) - 1;
+                nth_element(responses_.begin(), responses_.begin() + k, responses_.end());
+                return responses_[k];
+            }
+        }
+        return 0;
+    }
+
+private:
+    int choice_, tq_;
+    AdversaryMetric metric_;
+    vector<Process> work_;
+    DaryHeapRQ<4> rq_;
+    EngineWorkspace ws_;
+    Schedule out_;
+    vector<int> responses_;
+};
+
+struct SearchResult {
+    vector<Process> workload;
+    long long value = -1;
+    long long evaluations = 0;
+};
+
+SearchResult searchAdversary(int choice, int tq, AdversaryMetric metric, const SearchBounds &b,
+                             long long evaluations, unsigned seed) {
+    mt19937 rng(seed);
+    AdversaryEvaluator eval(choice, tq, metric);
+    uniform_int_distribution<int> arrival(0, b.latestArrival), burst(1, b.largestBurst),
+        prio(0, b.priorityLevels - 1), which(0, b.processes - 1), kind(0, 5), step(1, 3);
+    auto randomize = [&](Process &p) {
+        p.arrival = arrival(rng);
+        p.burst = p.remaining = burst(rng);
+        p.priority = prio(rng);
+    };
+    SearchResult best;
+    vector<Process> cur(b.processes);
+    for (int i = 0; i < b.processes; ++i) cur[i].pid = i + 1;
+    const long long restartEvery = 2000;
+    long long curValue = -1;
+    for (long long e = 0; e < evaluations; ++e) {
+        if (e % restartEvery == 0) {
+            for (auto &p : cur) randomize(p);
+            curValue = eval(cur);
+            if (curValue > best.value) best.value = curValue, best.workload = cur;
+            continue;
+        }
+        // one mutation, kept unless it makes the metric worse
+        int i = which(rng);
+        Process saved = cur[i];
+        Process &p = cur[i];
+        switch (kind(rng)) {
+            case 0: p.arrival = clamp(p.arrival + step(rng), 0, b.latestArrival); break;
+            case 1: p.arrival = clamp(p.arrival - step(rng), 0, b.latestArrival); break;
+            case 2: p.burst = p.remaining = clamp(p.burst + step(rng), 1, b.largestBurst); break;
+            case 3: p.burst = p.remaining = clamp(p.burst - step(rng), 1, b.largestBurst); break;
+            case 4: p.priority = prio(rng); break;
+            default: randomize(p); break;
+        }
+        long long v = eval(cur);
+        if (v >= curValue) curValue = v;
+        else cur[i] = saved;
+        if (curValue > best.value) best.value = curValue, best.workload = cur;
+    }
+    best.evaluations = evaluations;
+    return best;
+}
+
+// Greedy shrinking that keeps the metric at `target` or above
+vector<Process> minimizeReproducer(vector<Process> w, AdversaryEvaluator &eval, long long target) {
+    for (int i = (int)w.size() - 1; i >= 0 && w.size() > 1; --i) {
+        vector<Process> trial = w;
+        trial.erase(trial.begin() + i);
+        if (eval(trial) >= target) w = trial;
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        int first = INT_MAX;
+        for (auto &p : w) first = min(first, p.arrival);
+        for (auto &p : w) p.arrival -= first;
+        for (size_t i = 0; i < w.size(); ++i) {
+            for (int field = 0; field < 3; ++field) {
+                auto get = [&](Process &p) -> int & { return field == 0 ? p.burst : field == 1 ? p.arrival : p.priority; };
+                int lowest = field == 0 ? 1 : 0;
+                // largest decrease first
+                for (int d = get(w[i]) - lowest; d > 0; d /= 2) {
+                    while (get(w[i]) - d >= lowest) {
+                        vector<Process> trial = w;
+                        get(trial[i]) -= d;
+                        trial[i].remaining = trial[i].burst;
+                        if (eval(trial) < target) break;
+                        w = trial;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+    // ties break on row order (and pid for FCFS), so the tidied listing by
+    // arrival with pids 1..n is only kept if it still reaches the target
+    auto renumbered = [](vector<Process> v) {
+        for (size_t i = 0; i < v.size(); ++i) v[i].pid = (int)i + 1;
+        return v;
+    };
+    vector<Process> sorted = w;
+    stable_sort(sorted.begin(), sorted.end(), [](const Process &a, const Process &b){ return a.arrival < b.arrival; });
+    sorted = renumbered(sorted);
+    if (eval(sorted) >= target) return sorted;
+    vector<Process> kept = renumbered(w);
+    return eval(kept) >= target ? kept : w;
+}
+
+void runAdversarialSearch(int choice, int tq, AdversaryMetric metric, const SearchBounds &b, long long perThread,
+                          const string &csvPath) {
+    static const char *metricNames[] = {"", "max waiting time", "context switches", "p99 response time"};
+    perThread = max(perThread, 1LL);  // every thread scores at least its first workload
+    int threads = max(1u, thread::hardware_concurrency());
+    cout << "=== Adversarial Search: " << policyName(choice, tq) << ", maximize " << metricNames[(int)metric] << " ===\n";
+    cout << "Bounds: up to " << b.processes << " processes, arrivals 0.." << b.latestArrival << ", bursts 1.."
+         << b.largestBurst << ", priorities 0.." << b.priorityLevels - 1 << "; " << threads << " threads x "
+         << perThread << " evaluations\n";
+    vector<SearchResult> results(threads);
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back([&, t]{ results[t] = searchAdversary(choice, tq, metric, b, perThread, 7919u * (t + 1)); });
+    for (auto &th : pool) th.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    int bestThread = 0;
+    for (int t = 1; t < threads; ++t)
+        if (results[t].value > results[bestThread].value) bestThread = t;
+    const SearchResult &best = results[bestThread];
+    cout << "Searched " << (long long)threads * perThread << " workloads in " << fixed << setprecision(2) << secs
+         << " s (" << setprecision(0) << threads * perThread / max(secs, 1e-9) << " per second)\n";
+    cout << "Worst value found: " << best.value << " (thread " << bestThread << ")\n";
+
+    AdversaryEvaluator eval(choice, tq, metric);
+    vector<Process> repro = minimizeReproducer(best.workload, eval, best.value);
+    cout << "Minimized reproducer (" << repro.size() << " processes, " << metricNames[(int)metric] << " "
+         << eval(repro) << "):\n";
+    cout << "pid,arrival,burst,priority\n";
+    for (auto &p : repro) cout << p.pid << "," << p.arrival << "," << p.burst << "," << p.priority << "\n";
+    if (csvPath != "-") {
+        ofstream out(csvPath);
+        out << "pid,arrival,burst,priority\n";
+        for (auto &p : repro) out << p.pid << "," << p.arrival << "," << p.burst << "," << p.priority << "\n";
+        cout << (out ? "Wrote " : "Could not write ") << csvPath << "\n";
+    }
+    auto procs = repro;
+    Timeline g = runPolicyQuiet(choice, procs, tq);
+    computeAndPrintMetrics(procs, g);
+    printGantt(g);
+    cout << "\n";
+}
+
+// Prompt until a positive integer is entered (exits on end of input)
+int readPositiveInt(const string &prompt) {
+    int v;
+    cout << prompt;
+    while (!(cin >> v) || v <= 0) {
+        if (cin.eof()) exit(1);
+        cout << "Invalid value. Enter positive integer: ";
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+    return v;
+}
+
+double readPositiveDouble(const string &prompt) {
+    double v;
+    cout << prompt;
+    while (!(cin >> v) || v <= 0) {
+        if (cin.eof()) exit(1);
+        cout << "Invalid value. Enter positive number: ";
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+    return v;
+}
+
+int readQuantum() {
+    int tq;
+    cout << "Enter time quantum for Round Robin (positive integer): ";
+    while (!(cin >> tq) || tq <= 0) {
+        if (cin.eof()) exit(1);
+        cout << "Invalid quantum. Enter positive integer: ";
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+    return tq;
+}
+
+// Utility to read processes from console
+vector<Process> readFromConsole() {
+    int n;
+    while (true) {
+        cout << "Enter number of processes: ";
+        if (cin >> n && n > 0) break;
+        cout << "Invalid input. Enter a positive integer.\n";
+        cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+    vector<Process> procs(n);
+    for (int i = 0; i < n; ++i) {
+        procs[i].pid = i + 1;
+        cout << "=== Process " << procs[i].pid << " ===\n";
+        cout << "Arrival time: "; cin >> procs[i].arrival;
+        cout << "Burst time  : "; cin >> procs[i].burst;
+        cout << "Priority    : "; cin >> procs[i].priority;
+        procs[i].remaining = procs[i].burst;
+    }
+    return procs;
+}
+
+enum class CSVField { Pid, Arrival, Burst, Priority, Class, Memory, Ignored };
+
+// Column named in a CSV header; unknown columns are skipped
+CSVField csvFieldFromHeader(string name) {
+    name.erase(remove_if(name.begin(), name.end(), [](char c){ return isspace((unsigned char)c); }), name.end());
+    transform(name.begin(), name.end(), name.begin(), [](char c){ return (char)tolower((unsigned char)c); });
+    if (name == "pid" || name == "id") return CSVField::Pid;
+    if (name == "arrival") return CSVField::Arrival;
+    if (name == "burst") return CSVField::Burst;
+    if (name == "priority") return CSVField::Priority;
+    if (name == "class" || name == "tenant") return CSVField::Class;
+    if (name == "memory" || name == "mem") return CSVField::Memory;
+    return CSVField::Ignored;
+}
+
+// Parse one CSV data row. Without a header layout the row is
+// pid,arrival,burst,priority[,class] or arrival,burst,priority.
+Process parseCSVRow(const string &line, int defaultPid, const vector<CSVField> &layout = {}) {
+    stringstream ss(line);
+    vector<string> toks;
+    string tok;
+    while (getline(ss, tok, ',')) toks.push_back(tok);
+    vector<CSVField> fields = layout;
+    if (fields.empty()) {
+        using F = CSVField;
+        if (toks.size() == 3) fields = {F::Arrival, F::Burst, F::Priority};
+        else if (toks.size() == 4) fields = {F::Pid, F::Arrival, F::Burst, F::Priority};
+        else if (toks.size() == 5) fields = {F::Pid, F::Arrival, F::Burst, F::Priority, F::Class};
+        else throw runtime_error("CSV format invalid. Expected 3 to 5 columns.");
+    } else if (toks.size() != fields.size()) {
+        throw runtime_error("CSV row has " + to_string(toks.size()) + " columns, header has " + to_string(fields.size()));
+    }
+    Process p;
+    p.pid = defaultPid;
+    for (size_t c = 0; c < fields.size(); ++c) {
+        switch (fields[c]) {
+            case CSVField::Pid: p.pid = stoi(toks[c]); break;
+            case CSVField::Arrival: p.arrival = stoi(toks[c]); break;
+            case CSVField::Burst: p.burst = stoi(toks[c]); break;
+            case CSVField::Priority: p.priority = stoi(toks[c]); break;
+            case CSVField::Class: {
+                string name = toks[c];
+                name.erase(remove_if(name.begin(), name.end(), [](char ch){ return isspace((unsigned char)ch); }), name.end());
+                p.cls = classIndex(name.empty() ? "default" : name);
+                break;
+            }
+            case CSVField::Memory: p.memIntensity = stod(toks[c]); break;
+            case CSVField::Ignored: break;
+        }
+    }
+    p.remaining = p.burst;
+    return p;
+}
+
+// Pull-style CSV reader (pid optional). A first line whose first field is not
+// a number is a header naming the columns (pid, arrival, burst, priority, class, memory).
+class CSVProcessReader {
+public:
+    explicit CSVProcessReader(const string &path) : fin_(path) {}
+
+    bool isOpen() const { return fin_.is_open(); }
+
+    bool next(Process &p) {
+        string line;
+        while (getline(fin_, line)) {
+            if (line.size() == 0) continue;
+            if (first_) {
+                first_ = false;
+                string head = line.substr(0, line.find(','));
+                bool header = false;
+                for (char c : head) if (isalpha((unsigned char)c)) header = true;
+                if (header) {
+                    stringstream ss(line);
+                    string name;
+                    bool arrival = false, burst = false;
+                    while (getline(ss, name, ',')) {
+                        layout_.push_back(csvFieldFromHeader(name));
+                        arrival |= layout_.back() == CSVField::Arrival;
+                        burst |= layout_.back() == CSVField::Burst;
+                    }
+                    if (!arrival || !burst) throw runtime_error("CSV header needs arrival and burst columns.");
+                    continue;
+                }
+            }
+            p = parseCSVRow(line, ++rows_, layout_);
+            return true;
+        }
+        return false;
+    }
+
+private:
+    ifstream fin_;
+    bool first_ = true;
+    int rows_ = 0;
+    vector<CSVField> layout_;
+};
+
+// Stream processes from a CSV file one row at a time (pid optional).
+// Returns false if the file cannot be opened.
+bool forEachCSVProcess(const string &path, const function<void(const Process &)> &fn) {
+    CSVProcessReader reader(path);
+    if (!reader.isOpen()) {
+        cerr << "Failed to open CSV file: " << path << "\n";
+        return false;
+    }
+    Process p;
+    while (reader.next(p)) fn(p);
+    return true;
+}
+
+// Optionally read CSV file: pid,arrival,burst,priority (pid optional)
+vector<Process> readFromCSV(const string &path) {
+    vector<Process> procs;
+    forEachCSVProcess(path, [&](const Process &p){ procs.push_back(p); });
+    return procs;
+}
+
+// ---------------------------------------------------------------------------
+// Approximate simulation by trace sampling
+// ---------------------------------------------------------------------------
+// Thinning keeps each process with probability p and multiplies arrival times
+// by p, which preserves the arrival rate and therefore the offered load.
+// Windowing simulates R random windows of consecutive arrivals independently
+// (each window starts from an empty system, so queues that build up across a
+// window boundary are underestimated). Every replica yields one estimate per
+// metric; the report gives the replica mean and a 95% Student-t interval.
+
+const int NumApproxMetrics = 6;
+const char *approxMetricNames[NumApproxMetrics] = {
+    "Avg Waiting Time", "Avg Turnaround", "Avg Response Time",
+    "Context Switches", "Throughput", "CPU Utilization %"};
+
+using MetricVector = array<double, NumApproxMetrics>;
+
+// Context switches are a total, so a sample is scaled by the inverse sampling fraction
+MetricVector toMetricVector(const Metrics &m, double scale) {
+    return {m.avgWaiting, m.avgTurnaround, m.avgResponse, m.contextSwitches * scale, m.throughput, m.utilization};
+}
+
+double studentT975(int df) {
+    static const double table[] = {0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086};
+    if (df <= 0) return 0;
+    if (df <= 20) return table[df];
+    if (df <= 30) return 2.042;
+    if (df <= 60) return 2.000;
+    return 1.960;
+}
+
+struct Estimate {
+    double mean = 0;
+    double halfWidth = 0; // 95% confidence half-width
+};
+
+Estimate summarizeReplicas(const vector<double> &xs) {
+    Estimate e;
+    int r = (int)xs.size();
+    if (r == 0) return e;
+    for (double x : xs) e.mean += x;
+    e.mean /= r;
+    if (r < 2) return e;
+    double var = 0;
+    for (double x : xs) var += (x - e.mean) * (x - e.mean);
+    var /= (r - 1);
+    e.halfWidth = studentT975(r - 1) * sqrt(var / r);
+    return e;
+}
+
+// Deterministic uniform [0, 1) per (row, seed), so every replica draws an
+// independent, reproducible value for each row without storing it
+inline double hashUnit(unsigned long long row, unsigned seed) {
+    unsigned long long z = row * 0x9E3779B97F4A7C15ULL + seed * 0xBF58476D1CE4E5B9ULL + 0x94D049BB133111EBULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (double)(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Deterministic per-row coin so every replica sees an independent, reproducible sample
+inline bool sampleKeep(unsigned long long row, unsigned seed, double p) { return hashUnit(row, seed) < p; }
+
+inline void addThinned(vector<Process> &sample, const Process &p, double fraction) {
+    Process q = p;
+    q.arrival = (int)llround(p.arrival * fraction);
+    sample.push_back(q);
+}
+
+vector<Process> thinWorkload(const vector<Process> &procs, double fraction, unsigned seed) {
+    vector<Process> sample;
+    for (size_t i = 0; i < procs.size(); ++i)
+        if (sampleKeep(i, seed, fraction)) addThinned(sample, procs[i], fraction);
+    return sample;
+}
+
+// Consecutive arrivals [start, start+len), shifted so the window begins at time 0
+vector<Process> windowWorkload(const vector<Process> &byArrival, size_t start, size_t len) {
+    vector<Process> w(byArrival.begin() + start, byArrival.begin() + min(byArrival.size(), start + len));
+    int t0 = w.empty() ? 0 : w.front().arrival;
+    for (auto &p : w) p.arrival -= t0;
+    return w;
+}
+
+vector<MetricVector> sampleReplicas(const vector<Process> &procs, int choice, int tq, bool windows,
+                                    double fraction, int windowSize, int replicas) {
+    vector<MetricVector> out;
+    vector<Process> byArrival;
+    if (windows) {
+        byArrival = procs;
+        stable_sort(byArrival.begin(), byArrival.end(), [](const Process &a, const Process &b){ return a.arrival < b.arrival; });
+    }
+    mt19937 rng(2024);
+    for (int r = 0; r < replicas; ++r) {
+        vector<Process> sample;
+        double scale;
+        if (windows) {
+            size_t len = min<size_t>(windowSize, byArrival.size());
+            size_t start = uniform_int_distribution<size_t>(0, byArrival.size() - len)(rng);
+            sample = windowWorkload(byArrival, start, len);
+            scale = (double)procs.size() / max<size_t>(1, len);
+        } else {
+            sample = thinWorkload(procs, fraction, (unsigned)r + 1);
+            scale = 1.0 / fraction;
+        }
+        if (sample.empty()) continue;
+        out.push_back(toMetricVector(runPolicyMetrics(choice, sample, tq), scale));
+    }
+    return out;
+}
+
+vector<Estimate> estimateMetrics(const vector<MetricVector> &reps) {
+    vector<Estimate> est(NumApproxMetrics);
+    for (int k = 0; k < NumApproxMetrics; ++k) {
+        vector<double> xs;
+        for (auto &r : reps) xs.push_back(r[k]);
+        est[k] = summarizeReplicas(xs);
+    }
+    return est;
+}
+
+void printEstimates(const vector<Estimate> &est, const MetricVector *exact) {
+    cout << left << setw(20) << "Metric" << right << setw(14) << "Estimate" << setw(12) << "+/- 95%";
+    if (exact) cout << setw(14) << "Exact" << setw(10) << "RelErr%" << setw(8) << "in CI";
+    cout << "\n";
+    for (int k = 0; k < NumApproxMetrics; ++k) {
+        cout << left << setw(20) << approxMetricNames[k] << right << fixed << setprecision(3)
+             << setw(14) << est[k].mean << setw(12) << est[k].halfWidth;
+        if (exact) {
+            double x = (*exact)[k];
+            double rel = x != 0 ? (est[k].mean - x) / fabs(x) * 100.0 : 0.0;
+            bool inside = fabs(est[k].mean - x) <= est[k].halfWidth;
+            cout << setw(14) << x << setw(10) << setprecision(2) << rel << setw(8) << (inside ? "yes" : "no");
+        }
+        cout << "\n";
+    }
+}
+
+// Estimate metrics for the loaded workload, compare with the exact run, then
+// validate coverage on generated reference workloads at several loads
+void runApproximateAnalysis(const vector<Process> &procs, int choice, int tq, bool windows,
+                            double fraction, int windowSize, int replicas) {
+    cout << "=== Approximate Simulation: " << policyName(choice, tq) << " (";
+    if (windows) cout << "windows of " << windowSize;
+    else cout << "thinning p=" << fraction;
+    cout << ", " << replicas << " replicas) ===\n";
+    auto t0 = chrono::steady_clock::now();
+    auto est = estimateMetrics(sampleReplicas(procs, choice, tq, windows, fraction, windowSize, replicas));
+    auto t1 = chrono::steady_clock::now();
+    auto full = procs;
+    MetricVector exact = toMetricVector(runPolicyMetrics(choice, full, tq), 1.0);
+    auto t2 = chrono::steady_clock::now();
+    printEstimates(est, &exact);
+    cout << "Sampled run " << chrono::duration<double, milli>(t1 - t0).count() << " ms, full run "
+         << chrono::duration<double, milli>(t2 - t1).count() << " ms\n";
+
+    cout << "\nValidation on reference workloads (n=20000, 95% CI coverage of the exact value):\n";
+    for (double load : {0.5, 0.8, 0.95}) {
+        auto ref = generateWorkload(20000, load, 10, 8, 77);
+        auto exactRun = ref;
+        MetricVector x = toMetricVector(runPolicyMetrics(choice, exactRun, tq), 1.0);
+        auto e = estimateMetrics(sampleReplicas(ref, choice, tq, windows, fraction, windowSize, replicas));
+        int covered = 0;
+        double worst = 0;
+        for (int k = 0; k < NumApproxMetrics; ++k) {
+            if (fabs(e[k].mean - x[k]) <= e[k].halfWidth) covered++;
+            if (x[k] != 0) worst = max(worst, fabs(e[k].mean - x[k]) / fabs(x[k]) * 100.0);
+        }
+        cout << "load " << setprecision(2) << load << ": " << covered << "/" << NumApproxMetrics
+             << " metrics inside CI, worst relative error " << worst << "%\n";
+    }
+    cout << "\n";
+}
+
+// Thinned replicas are drawn while streaming the CSV, so memory is about
+// replicas * p * N processes and the full trace is never loaded
+void runStreamingApproximation(const string &path, int choice, int tq, double fraction, int replicas) {
+    cout << "=== Streaming Approximate Simulation: " << policyName(choice, tq) << " (p=" << fraction
+         << ", " << replicas << " replicas) ===\n";
+    vector<vector<Process>> samples(replicas);
+    unsigned long long row = 0;
+    bool ok = forEachCSVProcess(path, [&](const Process &p) {
+        for (int r = 0; r < replicas; ++r)
+            if (sampleKeep(row, (unsigned)r + 1, fraction)) addThinned(samples[r], p, fraction);
+        row++;
+    });
+    if (!ok) return;
+    vector<MetricVector> reps;
+    for (auto &s : samples) {
+        if (s.empty()) continue;
+        sort(s.begin(), s.end(), [](const Process &a, const Process &b){ return a.pid < b.pid; });
+        reps.push_back(toMetricVector(runPolicyMetrics(choice, s, tq), 1.0 / fraction));
+    }
+    cout << "Read " << row << " processes\n";
+    printEstimates(estimateMetrics(reps), nullptr);
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Perturbation sensitivity
+// ---------------------------------------------------------------------------
+// Replicas of one workload with multiplicative burst noise, arrival jitter or
+// priority swaps. A replica is only its seed: the perturbation of each row is
+// drawn from a counter-based hash of (row, replica), so replicas share the base
+// workload and each worker thread materializes one replica at a time in a reused
+// buffer. Per policy and metric the report gives the replica mean, standard
+// deviation and coefficient of variation, and the elasticity: the relative shift
+// of the mean metric divided by the relative size of the perturbation.
+
+enum class Perturbation { BurstNoise, ArrivalJitter, PrioritySwap };
+
+// magnitude: sigma of the mean-one log-normal burst factor, jitter as a fraction of the
+// mean inter-arrival gap, or the fraction of rows that swap priorities
+void perturbReplica(vector<Process> &work, const vector<Process> &base, Perturbation kind, double magnitude,
+                    unsigned replica) {
+    work = base;
+    size_t n = work.size();
+    switch (kind) {
+        case Perturbation::BurstNoise:
+            for (size_t i = 0; i < n; ++i) {
+                double u1 = max(hashUnit(2 * i, replica), 1e-12), u2 = hashUnit(2 * i + 1, replica);
+                double z = sqrt(-2 * log(u1)) * cos(2 * M_PI * u2);
+                work[i].burst = work[i].remaining = (int)max(1.0, min(1e9, round(base[i].burst * exp(magnitude * z - magnitude * magnitude / 2))));
+            }
+            break;
+        case Perturbation::ArrivalJitter: {
+            int first = INT_MAX, last = 0;
+            for (auto &p : base) first = min(first, p.arrival), last = max(last, p.arrival);
+            double jitter = magnitude * (last - first) / max<size_t>(1, n - 1);
+            for (size_t i = 0; i < n; ++i)
+                work[i].arrival = max(0, (int)llround(base[i].arrival + (2 * hashUnit(i, replica) - 1) * jitter));
+            break;
+        }
+        case Perturbation::PrioritySwap:
+            for (size_t i = 0; i < n; ++i)
+                if (hashUnit(i, replica) < magnitude)
+                    swap(work[i].priority, work[(size_t)(hashUnit(i + n, replica) * n) % n].priority);
+            break;
+    }
+}
+
+void runSensitivityAnalysis(const vector<Process> &base, int tq, double burstSigma, double jitter, double swapFraction,
+                            int replicas) {
+    const int shown = 4;  // waiting, turnaround, response, context switches
+    cout << "=== Perturbation Sensitivity (" << replicas << " replicas per perturbation) ===\n";
+    int threads = max(1u, thread::hardware_concurrency());
+    vector<pair<Perturbation, double>> kinds = {
+        {Perturbation::BurstNoise, burstSigma}, {Perturbation::ArrivalJitter, jitter},
+        {Perturbation::PrioritySwap, swapFraction}};
+    const char *kindNames[] = {"Burst noise (log-normal sigma ", "Arrival jitter (fraction of mean gap ",
+                               "Priority swaps (fraction of rows "};
+    auto t0 = chrono::steady_clock::now();
+    for (auto [kind, magnitude] : kinds) {
+        cout << kindNames[(int)kind] << magnitude << "):\n";
+        cout << left << setw(22) << "Policy" << setw(20) << "Metric" << right << setw(11) << "Base" << setw(11)
+             << "Mean" << setw(10) << "StdDev" << setw(8) << "CV%" << setw(11) << "Elasticity" << "\n";
+        if (magnitude <= 0) { cout << "(skipped)\n"; continue; }
+        for (int choice : {1, 2, 3, 4}) {
+            auto exact = base;
+            MetricVector baseline = toMetricVector(runPolicyMetrics(choice, exact, tq), 1.0);
+            vector<MetricVector> reps(replicas);
+            atomic<int> next{0};
+            vector<thread> pool;
+            for (int t = 0; t < threads; ++t)
+                pool.emplace_back([&]{
+                    vector<Process> work;
+                    for (int r; (r = next++) < replicas;) {
+                        perturbReplica(work, base, kind, magnitude, (unsigned)r + 1);
+                        reps[r] = toMetricVector(runPolicyMetrics(choice, work, tq), 1.0);
+                    }
+                });
+            for (auto &th : pool) th.join();
+            for (int k = 0; k < shown; ++k) {
+                double mean = 0, var = 0;
+                for (auto &m : reps) mean += m[k] / replicas;
+                for (auto &m : reps) var += (m[k] - mean) * (m[k] - mean) / max(1, replicas - 1);
+                double sd = sqrt(var);
+                cout << left << setw(22) << (k == 0 ? policyName(choice, tq) : "") << setw(20) << approxMetricNames[k]
+                     << right << fixed << setprecision(3) << setw(11) << baseline[k] << setw(11) << mean << setw(10)
+                     << sd << setw(8) << setprecision(1) << (mean != 0 ? 100 * sd / fabs(mean) : 0.0) << setw(11)
+                     << setprecision(3);
+                if (baseline[k] != 0) cout << (mean - baseline[k]) / fabs(baseline[k]) / magnitude << "\n";
+                else cout << "-" << "\n";
+            }
+        }
+    }
+    cout << "Replicas run on " << threads << " threads in " << fixed << setprecision(1)
+         << chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count() << " ms\n\n";
+}
+
+// ---------------------------------------------------------------------------
+// Memory-bandwidth and shared-cache interference
+// ---------------------------------------------------------------------------
+// Sockets of cores share a last-level cache and a memory bandwidth budget. A
+// process with memory intensity m spends a fraction m of its solo run stalled
+// on memory. On a socket whose running processes demand D = sum of m, that
+// stall grows by 1 + llc * (D - m) from cache pollution by the neighbours and
+// by D / bandwidth once the demand exceeds the bandwidth (in fully memory-bound
+// cores), so the execution rate is 1 / ((1 - m) + m * those factors). Rates
+// only change when a socket's set of running processes does, so they are
+// recomputed at events for the affected sockets and stay constant in between.
+
+enum class Placement { FirstFree = 1, Spread, InterferenceAware };
+
+struct MemoryModel {
+    int sockets = 1;
+    int coresPerSocket = 4;
+    double bandwidth = 2;  // memory demand a socket serves without slowdown
+    double llc = 0.5;      // stall growth per unit of neighbour memory intensity
+};
+
+struct InterferenceResult {
+    vector<double> completion;  // indexed like procs
+    double dilation = 1;        // CPU time occupied / solo burst time
+    double saturated = 0;       // fraction of socket time with demand above the bandwidth
+    long long events = 0;
+};
+
+string placementName(Placement p) {
+    switch (p) {
+        case Placement::FirstFree: return "First free";
+        case Placement::Spread: return "Spread";
+        case Placement::InterferenceAware: return "Interference-aware";
+    }
+    return "Unknown";
+}
+
+double interferenceRate(double m, double demand, const MemoryModel &mm) {
+    double stall = m * (1 + mm.llc * (demand - m)) * max(1.0, demand / mm.bandwidth);
+    return 1 / ((1 - m) + stall);
+}
+
+// Global ready queue over all cores, run to completion (tq = 0) or round robin.
+// InterferenceAware looks at the first `window` ready processes and starts the
+// one and the socket that raise the socket's total rate most; the head of the
+// queue is passed over at most `window` times in a row.
+InterferenceResult simulateInterference(const vector<Process> &procs, const MemoryModel &mm, Placement placement,
+                                        int tq, int window = 8) {
+    int n = (int)procs.size(), cores = mm.sockets * mm.coresPerSocket;
+    const double eps = 1e-9, inf = numeric_limits<double>::infinity();
+    InterferenceResult res;
+    res.completion.assign(n, 0);
+    vector<int> byArrival(n);
+    iota(byArrival.begin(), byArrival.end(), 0);
+    sort(byArrival.begin(), byArrival.end(), [&](int a, int b){
+        return procs[a].arrival != procs[b].arrival ? procs[a].arrival < procs[b].arrival : a < b;
+    });
+    vector<double> remaining(n), occupied(n, 0);
+    for (int i = 0; i < n; ++i) remaining[i] = procs[i].burst;
+    vector<int> job(cores, -1);
+    vector<double> rate(cores, 1), sliceEnd(cores, inf), demand(mm.sockets, 0);
+    vector<int> running(mm.sockets, 0);
+    vector<char> dirty(mm.sockets, 0);
+    deque<int> ready;
+    vector<int> expired;
+    int headSkips = 0, done = 0;
+    size_t next = 0;
+    double now = 0, saturatedTime = 0;
+
+    auto mem = [&](int i){ return min(1.0, max(0.0, procs[i].memIntensity)); };
+    // total rate of socket s with one more process of intensity m on it
+    auto socketRate = [&](int s, double m) {
+        double d = demand[s] + m, total = interferenceRate(m, d, mm);
+        for (int c = s * mm.coresPerSocket; c < (s + 1) * mm.coresPerSocket; ++c)
+            if (job[c] >= 0) total += interferenceRate(mem(job[c]), d, mm);
+        return total;
+    };
+    auto idleCore = [&](int s) {
+        for (int c = s * mm.coresPerSocket; c < (s + 1) * mm.coresPerSocket; ++c)
+            if (job[c] < 0) return c;
+        return -1;
+    };
+    auto start = [&](size_t pos, int s) {
+        int i = ready[pos], c = idleCore(s);
+        ready.erase(ready.begin() + pos);
+        job[c] = i;
+        sliceEnd[c] = tq > 0 ? now + tq : inf;
+        demand[s] += mem(i);
+        running[s]++;
+        dirty[s] = 1;
+    };
+    auto dispatch = [&]{
+        while (!ready.empty()) {
+            int bestSocket = -1;
+            size_t bestPos = 0;
+            if (placement == Placement::InterferenceAware && headSkips < window) {
+                double bestGain = -inf;
+                for (size_t pos = 0; pos < ready.size() && pos < (size_t)window; ++pos) {
+                    for (int s = 0; s < mm.sockets; ++s) {
+                        if (running[s] == mm.coresPerSocket) continue;
+                        double before = 0;
+                        for (int c = s * mm.coresPerSocket; c < (s + 1) * mm.coresPerSocket; ++c)
+                            if (job[c] >= 0) before += rate[c];
+                        double gain = socketRate(s, mem(ready[pos])) - before;
+                        if (gain > bestGain + eps) bestGain = gain, bestSocket = s, bestPos = pos;
+                    }
+                }
+                headSkips = bestPos > 0 ? headSkips + 1 : 0;
+            } else {
+                headSkips = 0;
+                for (int s = 0; s < mm.sockets; ++s) {
+                    if (running[s] == mm.coresPerSocket) continue;
+                    if (bestSocket < 0 || (placement == Placement::Spread && running[s] < running[bestSocket]))
+                        bestSocket = s;
+                    if (placement == Placement::FirstFree) break;
+                }
+            }
+            if (bestSocket < 0) break;
+            start(bestPos, bestSocket);
+        }
+    };
+
+    while (done < n) {
+        double t = next < byArrival.size() ? procs[byArrival[next]].arrival : inf;
+        for (int c = 0; c < cores; ++c)
+            if (job[c] >= 0) t = min(t, min(now + remaining[job[c]] / rate[c], sliceEnd[c]));
+        double dt = t - now;
+        for (int c = 0; c < cores; ++c) {
+            if (job[c] < 0) continue;
+            remaining[job[c]] -= rate[c] * dt;
+            occupied[job[c]] += dt;
+        }
+        for (int s = 0; s < mm.sockets; ++s)
+            if (demand[s] > mm.bandwidth + eps) saturatedTime += dt;
+        now = t;
+        ++res.events;
+
+        expired.clear();
+        for (int c = 0; c < cores; ++c) {
+            int i = job[c];
+            if (i < 0) continue;
+            bool finished = remaining[i] <= eps * max(1, procs[i].burst);
+            if (!finished && sliceEnd[c] > now + eps) continue;
+            int s = c / mm.coresPerSocket;
+            job[c] = -1;
+            demand[s] -= mem(i);
+            running[s]--;
+            dirty[s] = 1;
+            if (finished) res.completion[i] = now, ++done;
+            else expired.push_back(i);
+        }
+        while (next < byArrival.size() && procs[byArrival[next]].arrival <= now) ready.push_back(byArrival[next++]);
+        for (int i : expired) ready.push_back(i);
+        dispatch();
+        for (int s = 0; s < mm.sockets; ++s) {
+            if (!dirty[s]) continue;
+            dirty[s] = 0;
+            if (running[s] == 0) demand[s] = 0;  // drop accumulated rounding
+            for (int c = s * mm.coresPerSocket; c < (s + 1) * mm.coresPerSocket; ++c)
+                if (job[c] >= 0) rate[c] = interferenceRate(mem(job[c]), demand[s], mm);
+        }
+    }
+    double solo = 0, busy = 0;
+    for (int i = 0; i < n; ++i) solo += procs[i].burst, busy += occupied[i];
+    res.dilation = solo > 0 ? busy / solo : 1;
+    res.saturated = now > 0 ? saturatedTime / (now * mm.sockets) : 0;
+    return res;
+}
+
+// Workloads without a memory column get reproducible intensities: 30% of the
+// processes memory-bound (0.6 to 0.9), the rest compute-bound (below 0.2)
+void assignMemoryIntensity(vector<Process> &procs) {
+    for (auto &p : procs) if (p.memIntensity > 0) return;
+    for (size_t i = 0; i < procs.size(); ++i)
+        procs[i].memIntensity = hashUnit(i, 101) < 0.3 ? 0.6 + 0.3 * hashUnit(i, 102) : 0.2 * hashUnit(i, 102);
+}
+
+void runInterferenceAnalysis(const vector<Process> &loaded, const MemoryModel &mm, int tq) {
+    vector<Process> procs = loaded;
+    bool generated = all_of(procs.begin(), procs.end(), [](const Process &p){ return p.memIntensity <= 0; });
+    assignMemoryIntensity(procs);
+    double meanMem = 0;
+    for (auto &p : procs) meanMem += p.memIntensity / max<size_t>(1, procs.size());
+    cout << "=== Memory Interference (" << mm.sockets << " x " << mm.coresPerSocket << " cores, bandwidth "
+         << fixed << setprecision(2) << mm.bandwidth << ", llc " << mm.llc << ") ===\n"
+         << procs.size() << " processes, mean memory intensity " << meanMem
+         << (generated ? " (generated, no memory column)" : "") << "\n";
+    cout << left << setw(30) << "Run" << right << setw(10) << "AvgWT" << setw(10) << "AvgTAT" << setw(10)
+         << "Makespan" << setw(10) << "Dilation" << setw(11) << "Saturated" << setw(10) << "Events" << setw(9)
+         << "ms" << "\n";
+    MemoryModel isolated = mm;
+    isolated.bandwidth = numeric_limits<double>::infinity();
+    isolated.llc = 0;
+    for (int q : {0, tq}) {
+        string mode = q == 0 ? "FCFS" : "RR q=" + to_string(q);
+        for (int pl = 0; pl <= 3; ++pl) {
+            Placement placement = pl == 0 ? Placement::FirstFree : (Placement)pl;
+            auto t0 = chrono::steady_clock::now();
+            InterferenceResult r = simulateInterference(procs, pl == 0 ? isolated : mm, placement, q);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+            FluidRow row = fluidRow(procs, [&](int i){ return r.completion[i]; });
+            double makespan = r.completion.empty() ? 0 : *max_element(r.completion.begin(), r.completion.end());
+            cout << left << setw(30) << (mode + ", " + (pl == 0 ? "no interference" : placementName(placement)))
+                 << right << setprecision(2) << setw(10) << row.avgWaiting << setw(10) << row.avgTurnaround
+                 << setw(10) << makespan << setw(10) << r.dilation << setw(10) << r.saturated * 100 << "%"
+                 << setw(10) << r.events << setw(9) << ms << "\n";
+        }
+    }
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Lower bounds and optimality gaps
+// ---------------------------------------------------------------------------
+// On one CPU, preemptive SRPT minimizes the mean flow (turnaround) time, and
+// every work-conserving schedule reaches the smallest makespan. On m CPUs the
+// same SRPT run on one CPU of speed m is a relaxation (a job may use all m CPUs
+// at once), so max(sum of bursts, its total flow) bounds the total flow, and
+// the makespan is at least max over arrival times r of r + (work arriving at or
+// after r) / m, and at least every arrival + burst. All bounds cost O(n log n).
+// Tiny instances also get the exact non-preemptive optimum (total flow on m
+// CPUs, NP-hard in general) by a parallel branch and bound.
+
+// Total flow time of preemptive SRPT over (release, size) pairs on one CPU of the given speed
+double srptTotalFlow(vector<pair<double, double>> jobs, double speed) {
+    sort(jobs.begin(), jobs.end());
+    using Entry = pair<double, double>; // remaining size, release
+    priority_queue<Entry, vector<Entry>, greater<Entry>> active;
+    double now = 0, total = 0;
+    size_t next = 0;
+    while (next < jobs.size() || !active.empty()) {
+        double release = next < jobs.size() ? jobs[next].first : numeric_limits<double>::infinity();
+        if (active.empty()) now = max(now, release);
+        if (next < jobs.size() && jobs[next].first <= now) {
+            active.push({jobs[next].second, jobs[next].first});
+            ++next;
+            continue;
+        }
+        auto [rem, r] = active.top();
+        double finish = now + rem / speed;
+        active.pop();
+        if (finish <= release) {
+            now = finish;
+            total += now - r;
+        } else {
+            active.push({rem - (release - now) * speed, r});
+            now = release;
+        }
+    }
+    return total;
+}
+
+double makespanBound(const vector<Process> &procs, int cpus) {
+    vector<pair<int, int>> jobs;
+    for (auto &p : procs) jobs.push_back({p.arrival, p.burst});
+    sort(jobs.begin(), jobs.end());
+    double bound = 0, suffix = 0;
+    for (int k = (int)jobs.size() - 1; k >= 0; --k) {
+        suffix += jobs[k].second;
+        bound = max({bound, jobs[k].first + suffix / cpus, (double)jobs[k].first + jobs[k].second});
+    }
+    return bound;
+}
+
+LowerBounds workloadBounds(const vector<Process> &procs, int cpus) {
+    LowerBounds lb;
+    if (procs.empty()) return lb;
+    vector<pair<double, double>> jobs;
+    double work = 0;
+    for (auto &p : procs) jobs.push_back({(double)p.arrival, (double)p.burst}), work += p.burst;
+    lb.avgTurnaround = max(work, srptTotalFlow(jobs, cpus)) / procs.size();
+    lb.makespan = makespanBound(procs, cpus);
+    return lb;
+}
+
+struct ExactSchedule {
+    long long totalFlow = LLONG_MAX;
+    vector<int> order;      // start order; each job runs on the CPU that frees first
+    long long nodes = 0;
+    bool complete = true;   // false if the node limit stopped the search
+};
+
+// Total flow of running jobs in `order`, each on the earliest free of `cpus` CPUs
+long long listScheduleFlow(const vector<Process> &procs, const vector<int> &order, int cpus) {
+    priority_queue<long long, vector<long long>, greater<long long>> freeAt;
+    for (int c = 0; c < cpus; ++c) freeAt.push(0);
+    long long total = 0;
+    for (int i : order) {
+        long long end = max<long long>(freeAt.top(), procs[i].arrival) + procs[i].burst;
+        freeAt.pop();
+        freeAt.push(end);
+        total += end - procs[i].arrival;
+    }
+    return total;
+}
+
+// Exact minimum total flow without preemption. Any such schedule can be listed
+// in start order with each job on the CPU that frees first, so the search
+// branches on the next job. Branches are pruned by the SRPT relaxation of the
+// remaining jobs, by skipping a job when another could run and finish before
+// it would start, and by (CPU free times, flow) pairs already seen for the same
+// set of scheduled jobs. First choices are shared out among threads, which
+// share the incumbent.
+ExactSchedule exactNonPreemptive(const vector<Process> &procs, int cpus, long long nodeLimit = 200000000) {
+    int n = (int)procs.size();
+    ExactSchedule best;
+    if (n == 0) { best.totalFlow = 0; return best; }
+    if (n > 30) throw runtime_error("Exact search is limited to tiny instances");
+    vector<int> fcfs(n), spt;
+    iota(fcfs.begin(), fcfs.end(), 0);
+    stable_sort(fcfs.begin(), fcfs.end(), [&](int a, int b){ return procs[a].arrival < procs[b].arrival; });
+    {
+        // shortest available job first as a second incumbent
+        vector<char> used(n, 0);
+        long long t = 0;
+        for (int k = 0; k < n; ++k) {
+            int pick = -1;
+            for (int i = 0; i < n; ++i) {
+                if (used[i]) continue;
+                bool avail = procs[i].arrival <= t;
+                if (pick < 0) { pick = i; continue; }
+                bool pickAvail = procs[pick].arrival <= t;
+                if (avail != pickAvail ? avail
+                                       : avail ? procs[i].burst < procs[pick].burst : procs[i].arrival < procs[pick].arrival)
+                    pick = i;
+            }
+            used[pick] = 1;
+            spt.push_back(pick);
+            t = max<long long>(t, procs[pick].arrival) + procs[pick].burst;
+        }
+    }
+    for (auto *order : {&fcfs, &spt}) {
+        long long flow = listScheduleFlow(procs, *order, cpus);
+        if (flow < best.totalFlow) best.totalFlow = flow, best.order = *order;
+    }
+
+    atomic<long long> incumbent{best.totalFlow}, nodes{0};
+    atomic<bool> stopped{false};
+    atomic<int> nextRoot{0};
+    mutex bestMutex;
+    unsigned full = n == 32 ? ~0u : (1u << n) - 1;
+
+    auto worker = [&]{
+        struct Seen { vector<int> freeAt; long long flow; };
+        unordered_map<unsigned, vector<Seen>> seen;
+        vector<int> order;
+        long long localNodes = 0;
+        function<void(unsigned, vector<int> &, long long)> dfs = [&](unsigned mask, vector<int> &freeAt, long long flow) {
+            if (stopped.load(memory_order_relaxed)) return;
+            if (++localNodes % 65536 == 0 && nodes.fetch_add(65536) + 65536 > nodeLimit) stopped = true;
+            if (mask == full) {
+                lock_guard<mutex> lock(bestMutex);
+                if (flow < incumbent.load()) { incumbent = flow; best.totalFlow = flow; best.order = order; }
+                return;
+            }
+            int t0 = freeAt[0];
+            vector<pair<double, double>> rest;
+            long long direct = 0, shift = 0;
+            for (int i = 0; i < n; ++i) {
+                if (mask >> i & 1) continue;
+                int r = max(procs[i].arrival, t0);
+                rest.push_back({(double)r, (double)procs[i].burst});
+                direct += r + procs[i].burst - procs[i].arrival;
+                shift += r - procs[i].arrival;
+            }
+            double bound = max((double)direct, srptTotalFlow(rest, cpus) + shift);
+            if (flow + bound >= incumbent.load(memory_order_relaxed) - 1e-9) return;
+            auto &entries = seen[mask];
+            for (auto &e : entries) {
+                bool dominated = e.flow <= flow;
+                for (int c = 0; c < cpus && dominated; ++c) dominated = e.freeAt[c] <= freeAt[c];
+                if (dominated) return;
+            }
+            if (entries.size() < 16) entries.push_back({freeAt, flow});
+            int earliestEnd = INT_MAX;
+            for (int i = 0; i < n; ++i)
+                if (!(mask >> i & 1)) earliestEnd = min(earliestEnd, max(procs[i].arrival, t0) + procs[i].burst);
+            vector<int> cand;
+            for (int i = 0; i < n; ++i)
+                if (!(mask >> i & 1) && (max(procs[i].arrival, t0) < earliestEnd
+                                         || max(procs[i].arrival, t0) + procs[i].burst <= earliestEnd))
+                    cand.push_back(i);
+            sort(cand.begin(), cand.end(), [&](int a, int b){
+                return max(procs[a].arrival, t0) + procs[a].burst < max(procs[b].arrival, t0) + procs[b].burst;
+            });
+            for (int i : cand) {
+                int end = max(procs[i].arrival, t0) + procs[i].burst;
+                vector<int> child(freeAt.begin() + 1, freeAt.end());
+                child.insert(upper_bound(child.begin(), child.end(), end), end);
+                order.push_back(i);
+                dfs(mask | 1u << i, child, flow + end - procs[i].arrival);
+                order.pop_back();
+            }
+        };
+        for (int root; (root = nextRoot++) < n;) {
+            vector<int> freeAt(cpus, 0);
+            int end = procs[root].arrival + procs[root].burst;
+            vector<int> child(freeAt.begin() + 1, freeAt.end());
+            child.insert(upper_bound(child.begin(), child.end(), end), end);
+            order.assign(1, root);
+            dfs(1u << root, child, end - procs[root].arrival);
+        }
+        nodes += localNodes % 65536;
+    };
+    int threads = (int)min<unsigned>(max(1u, thread::hardware_concurrency()), (unsigned)n);
+    vector<thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto &t : pool) t.join();
+    best.nodes = nodes.load();
+    best.complete = !stopped.load();
+    return best;
+}
+
+// Gap of every policy against the bounds, on one CPU and on `cpus` CPUs
+void runOptimalityGaps(const vector<Process> &base, int tq, int cpus, int exactLimit) {
+    int n = (int)base.size();
+    cout << "=== Lower Bounds and Optimality Gaps (" << n << " processes) ===\n";
+    auto header = [&]{
+        cout << left << setw(34) << "Schedule" << right << setw(10) << "AvgTAT" << setw(9) << "Gap" << setw(10)
+             << "Makespan" << setw(9) << "Gap" << "\n";
+    };
+    auto row = [&](const string &name, double tat, double makespan, const LowerBounds &lb) {
+        cout << left << setw(34) << name << right << fixed << setprecision(3) << setw(10) << tat << setw(8)
+             << setprecision(1) << (lb.avgTurnaround > 0 ? (tat / lb.avgTurnaround - 1) * 100 : 0.0) << "%"
+             << setw(10) << setprecision(1) << makespan << setw(8)
+             << (lb.makespan > 0 ? (makespan / lb.makespan - 1) * 100 : 0.0) << "%\n";
+    };
+    auto exactRow = [&](int m, const LowerBounds &lb) {
+        if (n > exactLimit) {
+            cout << "(exact non-preemptive optimum skipped: more than " << exactLimit << " processes)\n";
+            return;
+        }
+        auto t0 = chrono::steady_clock::now();
+        ExactSchedule ex = exactNonPreemptive(base, m);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        priority_queue<long long, vector<long long>, greater<long long>> freeAt;
+        for (int c = 0; c < m; ++c) freeAt.push(0);
+        long long makespan = 0;
+        for (int i : ex.order) {
+            long long end = max<long long>(freeAt.top(), base[i].arrival) + base[i].burst;
+            freeAt.pop();
+            freeAt.push(end);
+            makespan = max(makespan, end);
+        }
+        row(ex.complete ? "Non-preemptive optimum (B&B)" : "Non-preemptive best found (B&B)",
+            (double)ex.totalFlow / n, (double)makespan, lb);
+        cout << "  " << ex.nodes << " nodes in " << setprecision(1) << ms << " ms, start order:";
+        for (int i : ex.order) cout << " P" << base[i].pid;
+        cout << "\n";
+    };
+
+    LowerBounds one = workloadBounds(base, 1);
+    cout << "1 CPU: AvgTAT >= " << fixed << setprecision(3) << one.avgTurnaround
+         << " (SRPT, optimal with preemption), makespan >= " << setprecision(1) << one.makespan << "\n";
+    header();
+    for (int choice : {1, 2, 3, 4, 5}) {
+        auto procs = base;
+        Metrics m = runPolicyMetrics(choice, procs, tq);
+        row(policyName(choice, tq), m.avgTurnaround, m.makespan, one);
+    }
+    vector<int> sizes;
+    for (auto &p : base) sizes.push_back(p.burst);
+    GittinsTable table = buildGittinsTable(sizes);
+    for (SizePolicy policy : {SizePolicy::LAS, SizePolicy::Gittins}) {
+        auto procs = base;
+        Schedule s = simulateSizeBased(procs, policy, policy == SizePolicy::Gittins ? &table : nullptr);
+        Metrics m = computeMetrics(procs, s);
+        row(policy == SizePolicy::LAS ? "FB / LAS" : "Gittins index", m.avgTurnaround, m.makespan, one);
+    }
+    exactRow(1, one);
+
+    if (cpus > 1) {
+        LowerBounds many = workloadBounds(base, cpus);
+        cout << "\n" << cpus << " CPUs: AvgTAT >= " << setprecision(3) << many.avgTurnaround
+             << " (SRPT at speed " << cpus << "), makespan >= " << setprecision(1) << many.makespan << "\n";
+        header();
+        MemoryModel mm;
+        mm.coresPerSocket = cpus;
+        mm.bandwidth = numeric_limits<double>::infinity();
+        mm.llc = 0;
+        for (int q : {0, tq}) {
+            InterferenceResult r = simulateInterference(base, mm, Placement::FirstFree, q);
+            double makespan = r.completion.empty() ? 0 : *max_element(r.completion.begin(), r.completion.end());
+            row(q == 0 ? "Global FCFS" : "Global Round Robin (q=" + to_string(q) + ")",
+                fluidRow(base, [&](int i){ return r.completion[i]; }).avgTurnaround, makespan, many);
+        }
+        exactRow(cpus, many);
+    }
+    cout << "\n";
+}
+
+#if __cplusplus >= 202002L
+// ---------------------------------------------------------------------------
+// Scripted processes (C++20 coroutines)
+// ---------------------------------------------------------------------------
+// A process's behaviour is a coroutine that co_awaits simulator primitives:
+// script::run(n) asks for n units of CPU, script::sleep(n) blocks for n units,
+// script::io(dev, n) queues an n-unit request on a FIFO device, script::lock(m)
+// and script::unlock(m) take and release a mutex (handed to the first waiter),
+// and script::spawn(task) starts a child process now. A suspended coroutine is
+// the process's state, so the engine only resumes it when its request is done.
+// One CPU runs the ready processes in Round Robin. Frames come from a pool of
+// free lists and processes are admitted as they arrive, so memory follows the
+// number of live processes, not the number simulated.
+
+// Free lists of coroutine frames by 64-byte size class; frames of finished
+// processes are reused by the next ones, so a run allocates only up to its peak
+class FramePool {
+public:
+    void *allocate(size_t bytes) {
+        size_t c = (bytes + 63) / 64;
+        ++live_;
+        peak_ = max(peak_, live_);
+        if (c < free_.size() && !free_[c].empty()) {
+            void *p = free_[c].back();
+            free_[c].pop_back();
+            return p;
+        }
+        size_t size = c * 64;
+        if (size > chunkBytes / 4) return ::operator new(size);
+        if (chunkLeft_ < size) {
+            chunks_.push_back(make_unique<char[]>(chunkBytes));
+            chunkNext_ = chunks_.back().get();
+            chunkLeft_ = chunkBytes;
+        }
+        void *p = chunkNext_;
+        chunkNext_ += size;
+        chunkLeft_ -= size;
+        return p;
+    }
+
+    void release(void *p, size_t bytes) {
+        size_t c = (bytes + 63) / 64;
+        --live_;
+        if (c * 64 > chunkBytes / 4) { ::operator delete(p); return; }
+        if (c >= free_.size()) free_.resize(c + 1);
+        free_[c].push_back(p);
+    }
+
+    long long peak() const { return peak_; }
+    size_t reservedBytes() const { return chunks_.size() * chunkBytes; }
+
+private:
+    static constexpr size_t chunkBytes = 1 << 20;
+    vector<vector<void *>> free_;
+    vector<unique_ptr<char[]>> chunks_;
+    char *chunkNext_ = nullptr;
+    size_t chunkLeft_ = 0;
+    long long live_ = 0, peak_ = 0;
+};
+
+FramePool &framePool() {
+    static FramePool pool;
+    return pool;
+}
+
+class ScriptSim;
+
+// Coroutine type of a scripted process; owns the frame until handed to the simulator
+struct ScriptTask {
+    struct promise_type {
+        ScriptSim *sim = nullptr;
+        int pid = -1;
+        ScriptTask get_return_object() { return ScriptTask(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { throw; }
+        static void *operator new(size_t bytes) { return framePool().allocate(bytes); }
+        static void operator delete(void *p, size_t bytes) { framePool().release(p, bytes); }
+    };
+    using Handle = coroutine_handle<promise_type>;
+
+    explicit ScriptTask(Handle h) : handle(h) {}
+    ScriptTask(ScriptTask &&o) noexcept : handle(exchange(o.handle, nullptr)) {}
+    ScriptTask &operator=(ScriptTask &&o) noexcept {
+        if (this != &o) { if (handle) handle.destroy(); handle = exchange(o.handle, nullptr); }
+        return *this;
+    }
+    ~ScriptTask() { if (handle) handle.destroy(); }
+    Handle release() { return exchange(handle, nullptr); }
+
+    Handle handle;
+};
+
+struct ScriptStats {
+    long long completed = 0, spawned = 0, events = 0, contextSwitches = 0, lockWaits = 0, peakLive = 0;
+    long long makespan = 0, cpuBusy = 0, deviceBusy = 0;
+    double turnaround = 0, readyWait = 0, lockWait = 0, ioWait = 0, sleeping = 0;  // totals
+};
+
+class ScriptSim {
+public:
+    ScriptSim(int tq, int devices, int mutexes) : tq_(tq), devices_(devices), owner_(mutexes, -1), waiters_(mutexes) {}
+
+    // Admits arrivals from `next` (time, task) in time order and runs until every process finished
+    void run(const function<bool(long long &, ScriptTask &)> &next) {
+        long long at = 0;
+        ScriptTask pending(nullptr);
+        bool more = next(at, pending);
+        const long long inf = LLONG_MAX;
+        while (true) {
+            while (more && at <= now_) {
+                add(pending.release(), at);
+                more = next(at, pending);
+            }
+            for (size_t k = 0; k < resume_.size(); ++k) resumeProc(resume_[k]);
+            resume_.clear();
+            if (preempted_ >= 0) { makeReady(preempted_); preempted_ = -1; }
+            if (running_ < 0 && !ready_.empty()) dispatch();
+            long long t = min(running_ >= 0 ? sliceEnd_ : inf, events_.empty() ? inf : events_.top().first);
+            if (more) t = min(t, at);
+            if (t == inf) break;
+            now_ = t;
+            ++stats_.events;
+            if (running_ >= 0 && sliceEnd_ == now_) {
+                Proc &p = procs_[running_];
+                long long used = now_ - sliceStart_;
+                p.remaining -= used;
+                stats_.cpuBusy += used;
+                if (p.remaining == 0) resume_.push_back(running_);
+                else preempted_ = running_;  // re-queued after this instant's wake-ups
+                running_ = -1;
+            }
+            while (!events_.empty() && events_.top().first == now_) {
+                int pid = events_.top().second;
+                events_.pop();
+                wake(pid);
+            }
+        }
+        if (live_ > 0) throw runtime_error(to_string(live_) + " scripted processes deadlocked on locks");
+        stats_.makespan = now_;
+    }
+
+    const ScriptStats &stats() const { return stats_; }
+
+    // Requests made by the awaiters of the running coroutine (pid)
+    void requestRun(int pid, long long n) {
+        procs_[pid].remaining = n;
+        makeReady(pid);
+    }
+
+    void requestSleep(int pid, long long n) {
+        block(pid, State::Sleeping);
+        events_.push({now_ + n, pid});
+    }
+
+    void requestIO(int pid, int dev, long long n) {
+        procs_[pid].ioDevice = dev % (int)devices_.size();
+        Device &d = devices_[procs_[pid].ioDevice];
+        block(pid, State::IO);
+        if (d.busy) d.queue.push_back({pid, n});
+        else startIO(d, pid, n);
+    }
+
+    // True if the mutex was free; otherwise the process waits for a hand-off
+    bool tryLock(int pid, int m) {
+        m %= (int)owner_.size();
+        if (owner_[m] < 0) { owner_[m] = pid; return true; }
+        ++stats_.lockWaits;
+        block(pid, State::Lock);
+        waiters_[m].push_back(pid);
+        return false;
+    }
+
+    void unlock(int m) {
+        m %= (int)owner_.size();
+        if (waiters_[m].empty()) { owner_[m] = -1; return; }
+        int pid = waiters_[m].front();
+        waiters_[m].pop_front();
+        owner_[m] = pid;
+        wake(pid);
+    }
+
+    int spawn(ScriptTask task) {
+        ++stats_.spawned;
+        return add(task.release(), now_);
+    }
+
+private:
+    enum class State : char { New, Ready, Running, Sleeping, IO, Lock };
+    struct Proc {
+        ScriptTask::Handle handle;
+        long long arrival = 0, remaining = 0, since = 0;
+        int ioDevice = 0;
+        State state = State::New;
+        long long serial = 0;  // admission number; ids of finished processes are reused
+    };
+    struct Device {
+        bool busy = false;
+        deque<pair<int, long long>> queue;
+    };
+
+    int add(ScriptTask::Handle h, long long at) {
+        int pid;
+        if (!freeIds_.empty()) { pid = freeIds_.back(); freeIds_.pop_back(); }
+        else { pid = (int)procs_.size(); procs_.emplace_back(); }
+        procs_[pid] = Proc{h, at, 0, at, 0, State::New, nextSerial_++};
+        h.promise().sim = this;
+        h.promise().pid = pid;
+        stats_.peakLive = max(stats_.peakLive, (long long)++live_);
+        resume_.push_back(pid);
+        return pid;
+    }
+
+    void makeReady(int pid) {
+        procs_[pid].state = State::Ready;
+        procs_[pid].since = now_;
+        ready_.push_back(pid);
+    }
+
+    void block(int pid, State s) {
+        procs_[pid].state = s;
+        procs_[pid].since = now_;
+    }
+
+    // A blocked process's request finished: account the wait and resume it at this instant
+    void wake(int pid) {
+        Proc &p = procs_[pid];
+        double waited = (double)(now_ - p.since);
+        if (p.state == State::Sleeping) stats_.sleeping += waited;
+        else if (p.state == State::Lock) stats_.lockWait += waited;
+        else if (p.state == State::IO) {
+            stats_.ioWait += waited;
+            Device &d = devices_[p.ioDevice];
+            d.busy = false;
+            if (!d.queue.empty()) {
+                auto [next, n] = d.queue.front();
+                d.queue.pop_front();
+                startIO(d, next, n);
+            }
+        }
+        resume_.push_back(pid);
+    }
+
+    void startIO(Device &d, int pid, long long n) {
+        d.busy = true;
+        stats_.deviceBusy += n;
+        events_.push({now_ + n, pid});
+    }
+
+    void dispatch() {
+        int pid = ready_.front();
+        ready_.pop_front();
+        Proc &p = procs_[pid];
+        stats_.readyWait += now_ - p.since;
+        if (p.serial != lastRun_ && lastRun_ >= 0) ++stats_.contextSwitches;
+        lastRun_ = p.serial;
+        p.state = State::Running;
+        running_ = pid;
+        sliceStart_ = now_;
+        sliceEnd_ = now_ + (tq_ > 0 ? min<long long>(tq_, p.remaining) : p.remaining);
+    }
+
+    void resumeProc(int pid) {
+        ScriptTask::Handle h = procs_[pid].handle;
+        h.resume();
+        if (!h.done()) return;
+        stats_.completed++;
+        stats_.turnaround += now_ - procs_[pid].arrival;
+        h.destroy();
+        procs_[pid].handle = nullptr;
+        freeIds_.push_back(pid);
+        --live_;
+    }
+
+    int tq_;
+    long long now_ = 0, sliceStart_ = 0, sliceEnd_ = 0;
+    int running_ = -1, preempted_ = -1, live_ = 0;
+    long long lastRun_ = -1, nextSerial_ = 0;  // serial of the last process on the CPU
+    vector<Proc> procs_;
+    vector<int> freeIds_, resume_;
+    deque<int> ready_;
+    priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<pair<long long, int>>> events_;
+    vector<Device> devices_;
+    vector<int> owner_;
+    vector<deque<int>> waiters_;
+    ScriptStats stats_;
+};
+
+namespace script {
+
+using Handle = ScriptTask::Handle;
+
+struct RunAwaiter {
+    long long n;
+    bool await_ready() const noexcept { return n <= 0; }
+    void await_suspend(Handle h) { h.promise().sim->requestRun(h.promise().pid, n); }
+    void await_resume() const noexcept {}
+};
+
+struct SleepAwaiter {
+    long long n;
+    bool await_ready() const noexcept { return n <= 0; }
+    void await_suspend(Handle h) { h.promise().sim->requestSleep(h.promise().pid, n); }
+    void await_resume() const noexcept {}
+};
+
+struct IOAwaiter {
+    int dev;
+    long long n;
+    bool await_ready() const noexcept { return n <= 0; }
+    void await_suspend(Handle h) { h.promise().sim->requestIO(h.promise().pid, dev, n); }
+    void await_resume() const noexcept {}
+};
+
+struct LockAwaiter {
+    int m;
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(Handle h) { return !h.promise().sim->tryLock(h.promise().pid, m); }
+    void await_resume() const noexcept {}
+};
+
+struct UnlockAwaiter {
+    int m;
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(Handle h) { h.promise().sim->unlock(m); return false; }
+    void await_resume() const noexcept {}
+};
+
+struct SpawnAwaiter {
+    ScriptTask child;
+    int pid = -1;
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(Handle h) { pid = h.promise().sim->spawn(std::move(child)); return false; }
+    int await_resume() const noexcept { return pid; }
+};
+
+inline RunAwaiter run(long long n) { return {n}; }
+inline SleepAwaiter sleep(long long n) { return {n}; }
+inline IOAwaiter io(int dev, long long n) { return {dev, n}; }
+inline LockAwaiter lock(int m) { return {m}; }
+inline UnlockAwaiter unlock(int m) { return {m}; }
+inline SpawnAwaiter spawn(ScriptTask child) { return {std::move(child)}; }
+
+}  // namespace script
+
+// `burst` units of compute in phases separated by I/O, each phase ending in a
+// `critical`-unit section under the mutex
+ScriptTask scriptedWorker(int phases, int burst, int critical, int ioTime, int dev, int mutex) {
+    int compute = burst - phases * critical;
+    for (int i = 0; i < phases; ++i) {
+        co_await script::run(compute / phases + (i < compute % phases));
+        if (critical > 0) {
+            co_await script::lock(mutex);
+            co_await script::run(critical);
+            co_await script::unlock(mutex);
+        }
+        if (i + 1 < phases) co_await script::io(dev, ioTime);
+    }
+}
+
+// Runs half of `burst`, hands the other half to a child, then sleeps for `ioTime`
+// and exits without waiting for the child
+ScriptTask scriptedForker(int burst, int ioTime, int dev, int mutex) {
+    co_await script::run((burst + 1) / 2);
+    if (burst / 2 > 0) co_await script::spawn(scriptedWorker(1, burst / 2, burst / 2 >= 2, ioTime, dev, mutex));
+    co_await script::sleep(ioTime);
+}
+
+// Scripts shaped from the workload rows, reused cyclically (each pass shifted
+// past the last arrival) until `count` processes have arrived
+void runScriptedProcesses(const vector<Process> &rows, int tq, long long count, int locks) {
+    if (rows.empty()) return;
+    const int devices = 2;
+    int span = 1;
+    for (auto &p : rows) span = max(span, p.arrival + 1);
+    long long nextIndex = 0;
+    auto source = [&](long long &at, ScriptTask &task) {
+        if (nextIndex >= count) return false;
+        long long i = nextIndex++;
+        const Process &p = rows[i % rows.size()];
+        at = p.arrival + (i / (long long)rows.size()) * span;
+        int burst = max(1, p.burst);
+        int phases = 1 + (int)(hashUnit(i, 201) * min(4, burst));
+        int critical = burst >= 2 * phases ? 1 : 0;
+        int ioTime = 1 + (int)(hashUnit(i, 202) * 5);
+        int dev = (int)(i % devices), mutex = (int)(hashUnit(i, 203) * locks);
+        if (i % 8 == 7) task = scriptedForker(burst, ioTime, dev, mutex);
+        else task = scriptedWorker(phases, burst, critical, ioTime, dev, mutex);
+        return true;
+    };
+    ScriptSim sim(tq, devices, locks);
+    auto t0 = chrono::steady_clock::now();
+    try { sim.run(source); }
+    catch (const exception &e) { cout << e.what() << "\n"; return; }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    const ScriptStats &s = sim.stats();
+    double n = max(1LL, s.completed);
+    cout << "=== Scripted Processes (C++20 coroutines, Round Robin q=" << tq << ") ===\n";
+    cout << count << " scripted processes + " << s.spawned << " spawned, " << devices << " devices, " << locks
+         << " locks\n" << fixed << setprecision(3);
+    cout << "Avg Turnaround    = " << s.turnaround / n << "\n";
+    cout << "Avg Ready Wait    = " << s.readyWait / n << "\n";
+    cout << "Avg Lock Wait     = " << s.lockWait / n << " (" << s.lockWaits << " contended acquisitions)\n";
+    cout << "Avg I/O Time      = " << s.ioWait / n << " (device utilization " << setprecision(1)
+         << 100.0 * s.deviceBusy / max(1LL, s.makespan * devices) << " %)\n" << setprecision(3);
+    cout << "Avg Sleep         = " << s.sleeping / n << "\n";
+    cout << "Context Switches  = " << s.contextSwitches << "\n";
+    cout << "CPU Utilization = " << setprecision(1) << 100.0 * s.cpuBusy / max(1LL, s.makespan) << " %, makespan "
+         << s.makespan << "\n";
+    cout << s.events << " events in " << ms << " ms (" << setprecision(0) << ms * 1e6 / max(1LL, s.events)
+         << " ns/event), peak " << s.peakLive << " live processes, " << framePool().peak() << " frames in "
+         << framePool().reservedBytes() / 1024 << " KB of pooled chunks\n\n";
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Bounded-memory runs with an on-disk columnar spill
+// ---------------------------------------------------------------------------
+// The trace is streamed in (arrival, pid) order. Only processes that have
+// arrived and not finished are resident; a finished process is folded into
+// the online summary, appended to one binary int32 file per column and its
+// slot is reused. Post-run queries map the column files read-only.
+
+const int SpillColumns = 6;
+const char *spillColumnNames[SpillColumns] = {"pid", "arrival", "burst", "priority", "start", "completion"};
+
+class ColumnSpill {
+public:
+    ColumnSpill(const string &prefix, size_t bufferRows) : bufferRows_(max<size_t>(1, bufferRows)) {
+        for (int c = 0; c < SpillColumns; ++c) {
+            files_[c].open(prefix + "." + spillColumnNames[c] + ".bin", ios::binary | ios::trunc);
+            if (!files_[c]) throw runtime_error("Cannot create spill file for column " + string(spillColumnNames[c]));
+            buf_[c].reserve(bufferRows_);
+        }
+    }
+    ~ColumnSpill() { flush(); }
+
+    void append(const Process &p) {
+        const int32_t row[SpillColumns] = {p.pid, p.arrival, p.burst, p.priority, p.start, p.completion};
+        for (int c = 0; c < SpillColumns; ++c) buf_[c].push_back(row[c]);
+        if (buf_[0].size() >= bufferRows_) flush();
+        rows_++;
+    }
+    void flush() {
+        for (int c = 0; c < SpillColumns; ++c) {
+            files_[c].write(reinterpret_cast<const char *>(buf_[c].data()), buf_[c].size() * sizeof(int32_t));
+            buf_[c].clear();
+            files_[c].flush();
+        }
+    }
+    long long rows() const { return rows_; }
+
+private:
+    size_t bufferRows_;
+    ofstream files_[SpillColumns];
+    vector<int32_t> buf_[SpillColumns];
+    long long rows_ = 0;
+};
+
+// Read-only memory map of the spilled columns
+class MappedSpill {
+public:
+    explicit MappedSpill(const string &prefix) {
+#ifdef __linux__
+        for (int c = 0; c < SpillColumns; ++c) {
+            string path = prefix + "." + spillColumnNames[c] + ".bin";
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw runtime_error("Cannot open spill file " + path);
+            struct stat st;
+            fstat(fd, &st);
+            len_[c] = (size_t)st.st_size;
+            if (len_[c] > 0) {
+                void *m = mmap(nullptr, len_[c], PROT_READ, MAP_SHARED, fd, 0);
+                if (m == MAP_FAILED) { close(fd); throw runtime_error("mmap failed for " + path); }
+                madvise(m, len_[c], MADV_SEQUENTIAL);
+                col_[c] = static_cast<const int32_t *>(m);
+            }
+            close(fd);
+        }
+        rows_ = len_[0] / sizeof(int32_t);
+#else
+        (void)prefix;
+        throw runtime_error("Spill queries need mmap (Linux)");
+#endif
+    }
+    ~MappedSpill() {
+#ifdef __linux__
+        for (int c = 0; c < SpillColumns; ++c)
+            if (col_[c]) munmap(const_cast<int32_t *>(col_[c]), len_[c]);
+#endif
+    }
+    MappedSpill(const MappedSpill &) = delete;
+    MappedSpill &operator=(const MappedSpill &) = delete;
+
+    size_t rows() const { return rows_; }
+    int32_t at(int column, size_t row) const { return col_[column][row]; }
+
+private:
+    const int32_t *col_[SpillColumns] = {};
+    size_t len_[SpillColumns] = {};
+    size_t rows_ = 0;
+};
+
+// Streams a sorted CSV trace through the event engine with at most `budgetBytes`
+// of process state (resident processes plus the spill buffers). Returns false on error.
+bool runBoundedMemory(const string &path, int choice, int tq, size_t budgetBytes, const string &spillPrefix,
+                      Metrics &summary) {
+    CSVProcessReader reader(path);
+    if (!reader.isOpen()) { cerr << "Failed to open CSV file: " << path << "\n"; return false; }
+    size_t residentBudget = max<size_t>(1, budgetBytes / 2 / sizeof(Process));
+    ColumnSpill spill(spillPrefix, budgetBytes / 2 / (SpillColumns * sizeof(int32_t)));
+
+    vector<Process> slots;
+    vector<long long> serial; // admission number of the process in each slot (slots are reused)
+    vector<int> freeSlots;
+    bool preemptive = (choice == 2 || choice == 3);
+    // keyed policies order by (key, pid), which matches the engine's index tie-break on pid-sorted input
+    using Entry = tuple<long long, long long, int, int>; // major, minor, pid, slot
+    priority_queue<Entry, vector<Entry>, greater<Entry>> keyed;
+    deque<int> fifo;
+    auto key = [&](int slot, int boost = 0) {
+        const Process &p = slots[slot];
+        return choice == 2 ? Entry{p.remaining - boost, 0, p.pid, slot}
+                           : Entry{p.priority - boost, p.remaining, p.pid, slot};
+    };
+    auto enqueue = [&](int slot) {
+        if (!preemptive) fifo.push_back(slot);
+        else keyed.push(key(slot));
+    };
+    auto readyEmpty = [&] { return preemptive ? keyed.empty() : fifo.empty(); };
+    auto popReady = [&] {
+        int slot;
+        if (preemptive) { slot = get<3>(keyed.top()); keyed.pop(); }
+        else { slot = fifo.front(); fifo.pop_front(); }
+        return slot;
+    };
+
+    ClassAccumulator classes;
+    Process pending;
+    bool havePending = reader.next(pending);
+    int lastArrival = INT_MIN, lastPid = INT_MIN;
+    size_t resident = 0, peakResident = 0;
+    long long admitted = 0;
+    bool warned = false, orderError = false;
+    auto admit = [&](int t) {
+        while (havePending && pending.arrival <= t) {
+            if (pending.arrival < lastArrival || (pending.arrival == lastArrival && pending.pid < lastPid)) {
+                orderError = true;
+                havePending = false;
+                return;
+            }
+            lastArrival = pending.arrival; lastPid = pending.pid;
+            int slot;
+            if (!freeSlots.empty()) { slot = freeSlots.back(); freeSlots.pop_back(); slots[slot] = pending; }
+            else { slot = (int)slots.size(); slots.push_back(pending); serial.push_back(0); }
+            serial[slot] = admitted++;
+            slots[slot].remaining = slots[slot].burst;
+            resident++;
+            peakResident = max(peakResident, resident);
+            if (resident > residentBudget && !warned) {
+                cerr << "Warning: " << resident << " runnable processes exceed the memory budget ("
+                     << residentBudget << "); runnable state cannot be spilled\n";
+                warned = true;
+            }
+            enqueue(slot);
+            havePending = reader.next(pending);
+        }
+    };
+
+    long double totalWT = 0, totalTAT = 0, totalResp = 0, totalBurst = 0;
+    long long completed = 0, slicesOut = 0;
+    int lastPidOut = 0, lastEndOut = -1;
+    auto emit = [&](int pid, int s, int e) {
+        if (e <= s) return;
+        if (!(pid == lastPidOut && lastEndOut == s)) slicesOut++;
+        lastPidOut = pid; lastEndOut = e;
+    };
+    auto finish = [&](int slot, int now) {
+        Process &p = slots[slot];
+        p.completion = now;
+        p.turnaround = now - p.arrival;
+        p.waiting = p.turnaround - p.burst;
+        totalWT += p.waiting; totalTAT += p.turnaround; totalResp += p.response; totalBurst += p.burst;
+        completed++;
+        classes.add(p);
+        spill.append(p);
+        freeSlots.push_back(slot);
+        resident--;
+    };
+
+    // The stepping of runEventEngine (without the compact round skipping), so the
+    // tuning knobs give the same schedule as a full in-memory run
+    long long lastOnCPU = -1; // serial of the last process on the CPU
+    auto dispatch = [&](int slot, int &now) {
+        Process &p = slots[slot];
+        if (contextSwitchCost > 0 && lastOnCPU >= 0 && lastOnCPU != serial[slot]) {
+            p.switchOverhead += contextSwitchCost;
+            now += contextSwitchCost;
+        }
+        lastOnCPU = serial[slot];
+        if (p.start == -1) p.start = now, p.response = now - p.arrival;
+    };
+
+    int now = 0, running = -1, sliceStart = 0, preemptTimer = INT_MAX;
+    while (true) {
+        admit(now);
+        if (orderError) break;
+        if (running < 0) {
+            if (readyEmpty()) {
+                if (!havePending) break;
+                now = max(now, pending.arrival);
+                continue;
+            }
+            running = popReady();
+            dispatch(running, now);
+            sliceStart = now;
+            preemptTimer = INT_MAX;
+        }
+        Process &p = slots[running];
+        int end = now + (choice == 4 ? min(tq, p.remaining) : p.remaining);
+        if (preemptive && havePending) end = max(now, min(end, pending.arrival));
+        if (preemptTimer < end) end = max(now, preemptTimer);
+        p.remaining -= end - now;
+        now = end;
+        if (p.remaining == 0) {
+            emit(p.pid, sliceStart, now);
+            finish(running, now);
+            running = -1;
+            continue;
+        }
+        int pid = p.pid; // admit may grow the slot table
+        admit(now);
+        if (orderError) break;
+        if (choice == 4) {
+            emit(pid, sliceStart, now);
+            enqueue(running);
+            running = -1;
+        } else if (preemptive && !readyEmpty()) {
+            if (minGranularity > 0 && now - sliceStart < minGranularity) {
+                preemptTimer = sliceStart + minGranularity;
+                continue;
+            }
+            preemptTimer = INT_MAX;
+            int best;
+            if (preemptThreshold == 0) {
+                enqueue(running);
+                best = popReady();
+            } else {
+                best = popReady();
+                if (key(best) < key(running, preemptThreshold)) enqueue(running);
+                else { keyed.push(key(best)); best = running; }
+            }
+            if (best != running) {
+                emit(pid, sliceStart, now);
+                running = best;
+                dispatch(running, now);
+                sliceStart = now;
+            }
+        }
+    }
+    spill.flush();
+    if (orderError) {
+        cerr << "Bounded-memory mode needs the trace sorted by (arrival, pid)\n";
+        return false;
+    }
+
+    long long n = max(1LL, completed);
+    summary = Metrics();
+    summary.completed = (int)min<long long>(completed, INT_MAX);
+    summary.avgWaiting = (double)(totalWT / n);
+    summary.avgTurnaround = (double)(totalTAT / n);
+    summary.avgResponse = (double)(totalResp / n);
+    summary.contextSwitches = (int)max(0LL, slicesOut - 1);
+    summary.makespan = max(0, lastEndOut);
+    summary.throughput = (double)completed / max(1, summary.makespan);
+    summary.utilization = (double)(totalBurst / max(1, summary.makespan) * 100.0);
+    cout << "Processed " << completed << " processes; peak resident " << peakResident << " ("
+         << peakResident * sizeof(Process) / 1024 << " KiB), spilled " << spill.rows() << " rows to "
+         << spillPrefix << ".*.bin\n";
+    if (classNames.size() > 1 || !classSLOs.empty()) classes.print();
+    return true;
+}
+
+// Exact percentile of a non-negative int column from a counting histogram over the map
+void printSpillPercentiles(const MappedSpill &m, const string &name, const function<long long(size_t)> &value) {
+    long long maxV = 0;
+    for (size_t r = 0; r < m.rows(); ++r) maxV = max(maxV, value(r));
+    const long long maxBuckets = 1 << 22;
+    long long width = max(1LL, (maxV + maxBuckets) / maxBuckets);
+    vector<long long> hist(maxV / width + 1, 0);
+    for (size_t r = 0; r < m.rows(); ++r) hist[max(0LL, value(r)) / width]++;
+    cout << name << ":";
+    for (double q : {0.5, 0.9, 0.99}) {
+        long long target = (long long)ceil(q * m.rows()), seen = 0;
+        size_t b = 0;
+        while (b < hist.size() && (seen += hist[b]) < target) ++b;
+        cout << "  p" << (int)(q * 100) << "=" << (long long)b * width;
+    }
+    cout << "  max=" << maxV << (width > 1 ? " (bucket width " + to_string(width) + ")" : "") << "\n";
+}
+
+void querySpill(const string &prefix) {
+    MappedSpill m(prefix);
+    cout << "\nSpill queries (" << m.rows() << " rows, memory-mapped):\n";
+    auto waiting = [&](size_t r) { return (long long)m.at(5, r) - m.at(1, r) - m.at(2, r); };
+    auto turnaround = [&](size_t r) { return (long long)m.at(5, r) - m.at(1, r); };
+    auto response = [&](size_t r) { return (long long)m.at(4, r) - m.at(1, r); };
+    printSpillPercentiles(m, "Waiting   ", waiting);
+    printSpillPercentiles(m, "Turnaround", turnaround);
+    printSpillPercentiles(m, "Response  ", response);
+
+    using Top = pair<long long, int>;
+    priority_queue<Top, vector<Top>, greater<Top>> top;
+    for (size_t r = 0; r < m.rows(); ++r) {
+        top.push({waiting(r), (int)r});
+        if (top.size() > 5) top.pop();
+    }
+    vector<Top> worst;
+    while (!top.empty()) { worst.push_back(top.top()); top.pop(); }
+    cout << "Longest waits:";
+    for (auto it = worst.rbegin(); it != worst.rend(); ++it) cout << " P" << m.at(0, it->second) << "(" << it->first << ")";
+    cout << "\n";
+
+    while (true) {
+        cout << "Look up pid (0 to finish): ";
+        long long pid;
+        if (!(cin >> pid) || pid == 0) break;
+        bool found = false;
+        for (size_t r = 0; r < m.rows() && !found; ++r) {
+            if (m.at(0, r) != pid) continue;
+            found = true;
+            cout << "P" << pid << " : Arrival=" << m.at(1, r) << ", Burst=" << m.at(2, r) << ", Priority=" << m.at(3, r)
+                 << ", Start=" << m.at(4, r) << ", Completion=" << m.at(5, r) << ", WT=" << waiting(r)
+                 << ", TAT=" << turnaround(r) << ", Resp=" << response(r) << "\n";
+        }
+        if (!found) cout << "P" << pid << " not found\n";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Host calibration
+// ---------------------------------------------------------------------------
+// --calibrate=<file> measures this Linux host and writes `key=value` lines
+// (nanoseconds): thread context switches by pipe and futex ping-pong between
+// two threads pinned to one CPU, cross-core wake-ups and self-migration, the
+// cost of refilling the cache after another process evicted a working set,
+// and clock reads and short-sleep overshoot. --calibration=<file> loads such
+// a file and sets the switch cost to one futex switch plus the refill of the
+// chosen working set, in simulator time units of time_unit_ns.
+
+struct Calibration {
+    double timeUnitNs = 1000;
+    int workingSetKB = 256;
+    map<string, double> values;
+};
+
+#ifdef __linux__
+namespace calibration {
+
+bool pinTo(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+double nowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void futexWait(atomic<int> &word, int value) {
+    syscall(SYS_futex, reinterpret_cast<int *>(&word), FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+}
+void futexWake(atomic<int> &word) {
+    syscall(SYS_futex, reinterpret_cast<int *>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+// Round trip (ns) of a futex ping-pong between threads on cpuA and cpuB
+double futexRoundTrip(int cpuA, int cpuB, int rounds) {
+    atomic<int> turn{0};
+    thread peer([&]{
+        pinTo(cpuB);
+        for (int i = 0; i < rounds; ++i) {
+            while (turn.load() != 1) futexWait(turn, 0);
+            turn.store(0);
+            futexWake(turn);
+        }
+    });
+    pinTo(cpuA);
+    double t0 = nowNs();
+    for (int i = 0; i < rounds; ++i) {
+        turn.store(1);
+        futexWake(turn);
+        while (turn.load() != 0) futexWait(turn, 1);
+    }
+    double t = nowNs() - t0;
+    peer.join();
+    return t / rounds;
+}
+
+// Round trip (ns) of a one-byte pipe ping-pong between two threads on one CPU
+double pipeRoundTrip(int cpu, int rounds) {
+    int ab[2], ba[2];
+    if (pipe(ab) || pipe(ba)) return 0;
+    thread peer([&]{
+        pinTo(cpu);
+        char c;
+        for (int i = 0; i < rounds; ++i)
+            if (read(ab[0], &c, 1) != 1 || write(ba[1], &c, 1) != 1) break;
+    });
+    pinTo(cpu);
+    char c = 0;
+    double t0 = nowNs();
+    for (int i = 0; i < rounds; ++i)
+        if (write(ab[1], &c, 1) != 1 || read(ba[0], &c, 1) != 1) break;
+    double t = nowNs() - t0;
+    peer.join();
+    for (int fd : {ab[0], ab[1], ba[0], ba[1]}) close(fd);
+    return t / rounds;
+}
+
+// The same write/read pair without a second thread: the system-call part of a round trip
+double pipeSyscalls(int rounds) {
+    int p[2];
+    if (pipe(p)) return 0;
+    char c = 0;
+    double t0 = nowNs();
+    for (int i = 0; i < rounds; ++i)
+        if (write(p[1], &c, 1) != 1 || read(p[0], &c, 1) != 1) break;
+    double t = nowNs() - t0;
+    close(p[0]);
+    close(p[1]);
+    return t / rounds;
+}
+
+// Time (ns) to touch one byte per cache line of `buf`
+double touch(vector<char> &buf) {
+    double t0 = nowNs();
+    for (size_t i = 0; i < buf.size(); i += 64) buf[i]++;
+    return nowNs() - t0;
+}
+
+}  // namespace calibration
+
+Calibration calibrateHost() {
+    using namespace calibration;
+    Calibration c;
+    auto &v = c.values;
+    int cpus = max(1u, thread::hardware_concurrency());
+    cpu_set_t saved;
+    sched_getaffinity(0, sizeof(saved), &saved);
+    const int rounds = 20000;
+
+    // two switches per round trip, after taking out the system calls
+    double syscalls = pipeSyscalls(rounds);
+    v["pipe_round_trip_ns"] = pipeRoundTrip(0, rounds);
+    v["context_switch_pipe_ns"] = max(0.0, (v["pipe_round_trip_ns"] - 2 * syscalls) / 2);
+    v["context_switch_futex_ns"] = futexRoundTrip(0, 0, rounds) / 2;
+    if (cpus > 1) {
+        v["cross_core_wakeup_ns"] = futexRoundTrip(0, 1, rounds) / 2;
+        const int moves = 2000;
+        double t0 = nowNs();
+        for (int i = 0; i < moves; ++i) pinTo(i % 2);
+        double moving = (nowNs() - t0) / moves;
+        t0 = nowNs();
+        for (int i = 0; i < moves; ++i) pinTo(0);
+        v["migration_ns"] = max(0.0, moving - (nowNs() - t0) / moves);
+    }
+    pinTo(0);
+
+    // warm re-touch against a re-touch after a 64 MB sweep evicted the set
+    vector<char> evict(64 << 20, 1);
+    for (int kb : {16, 256, 4096, 32768}) {
+        vector<char> ws((size_t)kb << 10, 1);
+        double warm = 1e18, cold = 1e18;
+        for (int rep = 0; rep < 5; ++rep) {
+            touch(ws);
+            warm = min(warm, touch(ws));
+            touch(evict);
+            cold = min(cold, touch(ws));
+        }
+        v["cache_refill_" + to_string(kb) + "kb_ns"] = max(0.0, cold - warm);
+    }
+
+    const int reads = 1000000;
+    double t0 = nowNs();
+    for (int i = 0; i < reads; ++i) nowNs();
+    v["clock_read_ns"] = (nowNs() - t0) / reads;
+    const int sleeps = 200;
+    double over = 0;
+    for (int i = 0; i < sleeps; ++i) {
+        timespec req{0, 1000};
+        double s = nowNs();
+        nanosleep(&req, nullptr);
+        over += nowNs() - s - 1000;
+    }
+    v["sleep_1us_overshoot_ns"] = over / sleeps;
+    sched_setaffinity(0, sizeof(saved), &saved);
+    return c;
+}
+#else
+Calibration calibrateHost() { throw runtime_error("Host calibration needs Linux"); }
+#endif
+
+void writeCalibration(const Calibration &c, const string &path) {
+    ofstream out(path);
+    if (!out) throw runtime_error("Cannot write " + path);
+    out << "# Host calibration for --calibration; times in ns\n"
+        << "# switch cost = context_switch_futex_ns + cache_refill_<working_set_kb>kb_ns, in time_unit_ns units\n"
+        << "time_unit_ns=" << c.timeUnitNs << "\n"
+        << "working_set_kb=" << c.workingSetKB << "\n";
+    for (auto &[key, value] : c.values) out << key << "=" << fixed << setprecision(1) << value << "\n";
+}
+
+Calibration readCalibration(const string &path) {
+    ifstream in(path);
+    if (!in) throw runtime_error("Cannot open " + path);
+    Calibration c;
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        size_t eq = line.find('=');
+        if (eq == string::npos) continue;
+        string key = line.substr(0, eq);
+        double value = atof(line.c_str() + eq + 1);
+        if (key == "time_unit_ns") c.timeUnitNs = value;
+        else if (key == "working_set_kb") c.workingSetKB = (int)value;
+        else c.values[key] = value;
+    }
+    if (c.timeUnitNs <= 0) throw runtime_error("time_unit_ns must be positive");
+    return c;
+}
+
+// Switch cost in time units: one futex switch plus the refill of the largest
+// measured working set not above working_set_kb
+int calibratedSwitchCost(const Calibration &c) {
+    auto get = [&](const string &key) { auto it = c.values.find(key); return it == c.values.end() ? 0.0 : it->second; };
+    double refill = 0;
+    int best = -1;
+    for (auto &[key, value] : c.values) {
+        int kb;
+        if (sscanf(key.c_str(), "cache_refill_%dkb_ns", &kb) == 1 && kb <= c.workingSetKB && kb > best) best = kb, refill = value;
+    }
+    return (int)llround((get("context_switch_futex_ns") + refill) / c.timeUnitNs);
+}
+
+void printCalibration(const Calibration &c) {
+    for (auto &[key, value] : c.values) cout << "  " << left << setw(28) << key << right << fixed << setprecision(1) << setw(14) << value << "\n";
+    cout << "  switch cost at " << c.workingSetKB << " KB working set, " << c.timeUnitNs << " ns per time unit: "
+         << calibratedSwitchCost(c) << " units\n";
+}
+
+// ---------------------------------------------------------------------------
+// Real-kernel comparison
+// ---------------------------------------------------------------------------
+// Runs the workload as Linux threads pinned to one CPU: each thread sleeps
+// until its arrival, then spins until its own CPU clock has consumed its burst.
+// Priorities map to nice values under SCHED_OTHER (lower value = higher
+// priority = lower nice) or to real-time priorities under SCHED_RR/SCHED_FIFO
+// when permitted. Start is the first time the thread runs after its arrival and
+// completion the moment its CPU clock reaches the burst; the metrics are
+// printed next to the simulated policies.
+
+struct KernelRun {
+    string policy;
+    vector<double> start, completion;  // time units since the common time origin
+    long long involuntarySwitches = 0;
+};
+
+#ifdef __linux__
+KernelRun runOnKernel(const vector<Process> &procs, int kernelPolicy, double unitMs) {
+    using calibration::nowNs;
+    KernelRun run;
+    int n = (int)procs.size();
+    run.start.assign(n, 0);
+    run.completion.assign(n, 0);
+    int minPriority = INT_MAX;
+    for (auto &p : procs) minPriority = min(minPriority, p.priority);
+    cpu_set_t saved;
+    sched_getaffinity(0, sizeof(saved), &saved);
+    int cpu = 0;
+    while (cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &saved)) ++cpu;
+
+    // real-time policies need CAP_SYS_NICE; fall back to SCHED_OTHER without it
+    int policy = kernelPolicy == 2 ? SCHED_RR : kernelPolicy == 3 ? SCHED_FIFO : SCHED_OTHER;
+    if (policy != SCHED_OTHER) {
+        sched_param probe{1};
+        if (pthread_setschedparam(pthread_self(), policy, &probe) != 0) {
+            cout << "No permission for " << (policy == SCHED_RR ? "SCHED_RR" : "SCHED_FIFO")
+                 << "; using SCHED_OTHER with nice values\n";
+            policy = SCHED_OTHER;
+        } else {
+            sched_param normal{0};
+            pthread_setschedparam(pthread_self(), SCHED_OTHER, &normal);
+        }
+    }
+    run.policy = policy == SCHED_RR ? "SCHED_RR" : policy == SCHED_FIFO ? "SCHED_FIFO" : "SCHED_OTHER";
+
+    // the origin leaves every thread time to configure itself and reach its sleep
+    atomic<long long> switches{0};
+    double origin = nowNs() + 20e6 + n * 0.5e6;
+    vector<thread> threads;
+    for (int i = 0; i < n; ++i) {
+        threads.emplace_back([&, i]{
+            calibration::pinTo(cpu);
+            int level = procs[i].priority - minPriority;
+            if (policy == SCHED_OTHER) {
+                setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), min(19, level));
+            } else {
+                sched_param sp{max(1, 50 - level)};
+                pthread_setschedparam(pthread_self(), policy, &sp);
+            }
+            double arrival = origin + procs[i].arrival * unitMs * 1e6;
+            timespec at{(time_t)(arrival / 1e9), (long)fmod(arrival, 1e9)};
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &at, nullptr);
+            run.start[i] = (nowNs() - origin) / (unitMs * 1e6);
+            timespec cpu0, cpuNow;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu0);
+            double need = procs[i].burst * unitMs * 1e6;
+            do clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuNow);
+            while ((cpuNow.tv_sec - cpu0.tv_sec) * 1e9 + (cpuNow.tv_nsec - cpu0.tv_nsec) < need);
+            run.completion[i] = (nowNs() - origin) / (unitMs * 1e6);
+            rusage ru;
+            getrusage(RUSAGE_THREAD, &ru);
+            switches += ru.ru_nivcsw;
+        });
+    }
+    for (auto &t : threads) t.join();
+    run.involuntarySwitches = switches.load();
+    return run;
+}
+#else
+KernelRun runOnKernel(const vector<Process> &, int, double) { throw runtime_error("Kernel comparison needs Linux"); }
+#endif
+
+void runKernelComparison(const vector<Process> &base, int kernelPolicy, double unitMs, int tq) {
+    long long work = 0;
+    for (auto &p : base) work += p.burst;
+    cout << fixed << setprecision(1) << "=== Real-Kernel Comparison (" << base.size() << " threads, 1 time unit = "
+         << unitMs << " ms, " << work * unitMs / 1000 << " s of CPU) ===\n";
+    KernelRun k = runOnKernel(base, kernelPolicy, unitMs);
+    cout << "Linux " << k.policy << " on one CPU, " << k.involuntarySwitches << " involuntary context switches\n";
+    cout << left << setw(6) << "PID" << right << setw(8) << "Arr" << setw(8) << "Burst" << setw(6) << "Prio"
+         << setw(11) << "Start" << setw(12) << "Completion" << setw(10) << "TAT" << "\n";
+    for (size_t i = 0; i < base.size(); ++i)
+        cout << left << setw(6) << ("P" + to_string(base[i].pid)) << right << setw(8) << base[i].arrival << setw(8)
+             << base[i].burst << setw(6) << base[i].priority << setprecision(2) << setw(11) << k.start[i] << setw(12)
+             << k.completion[i] << setw(10) << k.completion[i] - base[i].arrival << "\n";
+
+    cout << "\n" << left << setw(24) << "Run" << right << setw(10) << "AvgWT" << setw(10) << "AvgTAT" << setw(10)
+         << "AvgResp" << setw(10) << "Makespan" << setw(10) << "Switches" << "\n";
+    auto row = [&](const string &name, const function<double(int)> &start, const function<double(int)> &done,
+                   const string &switches) {
+        double wt = 0, tat = 0, resp = 0, end = 0;
+        int n = max(1, (int)base.size());
+        for (int i = 0; i < (int)base.size(); ++i) {
+            tat += (done(i) - base[i].arrival) / n;
+            wt += (done(i) - base[i].arrival - base[i].burst) / n;
+            resp += (start(i) - base[i].arrival) / n;
+            end = max(end, done(i));
+        }
+        cout << left << setw(24) << name << right << setprecision(2) << setw(10) << wt << setw(10) << tat << setw(10)
+             << resp << setw(10) << end << setw(10) << switches << "\n";
+    };
+    row("Linux " + k.policy, [&](int i){ return k.start[i]; }, [&](int i){ return k.completion[i]; },
+        to_string(k.involuntarySwitches));
+    for (int choice : {4, 3, 5, 1}) {
+        auto procs = base;
+        Schedule s = runPolicySchedule(choice, procs, tq);
+        sort(procs.begin(), procs.end(), [](const Process &a, const Process &b){ return a.pid < b.pid; });
+        vector<int> order(base.size());
+        for (size_t i = 0; i < base.size(); ++i)
+            order[i] = (int)(lower_bound(procs.begin(), procs.end(), base[i].pid,
+                                         [](const Process &p, int pid){ return p.pid < pid; }) - procs.begin());
+        row(policyName(choice, tq), [&](int i){ return (double)procs[order[i]].start; },
+            [&](int i){ return (double)procs[order[i]].completion; }, to_string(countContextSwitches(s)));
+    }
+    cout << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Self-test
+// ---------------------------------------------------------------------------
+// --selftest replays seeded generated workloads and checks the equivalences
+// the fast paths rely on: every engine gives the tick simulators' schedule,
+// compact runs (Round Robin round skipping) keep every start and completion and
+// the switch count, the engines agree with each other under the tuning knobs,
+// and the EEVDF treap picks what a linear scan picks. Returns the number of
+// failed checks.
+
+int runSelfTest() {
+    int savedCost = contextSwitchCost, savedThr = preemptThreshold, savedGran = minGranularity;
+    long long checks = 0;
+    int failures = 0;
+    auto fail = [&](const string &what) {
+        if (++failures <= 10) cout << "FAIL: " << what << "\n";
+    };
+    auto sameProcesses = [](const vector<Process> &a, const vector<Process> &b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i)
+            if (a[i].pid != b[i].pid || a[i].start != b[i].start || a[i].completion != b[i].completion) return false;
+        return true;
+    };
+    auto sameSchedule = [](const Schedule &a, const Schedule &b) {
+        if (a.size() != b.size() || a.compactedSlices != b.compactedSlices) return false;
+        for (size_t i = 0; i < a.size(); ++i)
+            if (a[i].pid != b[i].pid || a[i].start != b[i].start || a[i].end != b[i].end) return false;
+        return true;
+    };
+
+    unsigned seed = 1;
+    for (int n : {1, 7, 40, 130, 300, 600})
+    for (double load : {0.6, 1.3})
+    for (auto [maxBurst, levels] : {pair<int, int>{9, 4}, {100, 300}}) {
+        vector<Process> base = generateWorkload(n, load, maxBurst, levels, seed++);
+        WorkloadShape w = inspectWorkload(base);
+        string where = "n=" + to_string(n) + " load=" + to_string(load).substr(0, 3) + " maxBurst=" +
+                       to_string(maxBurst) + " levels=" + to_string(levels);
+        for (int choice = 1; choice <= 4; ++choice)
+        for (int tq : {1, 3}) {
+            if (choice != 4 && tq != 1) continue;
+            string run = policyName(choice, tq) + ", " + where;
+            contextSwitchCost = preemptThreshold = minGranularity = 0;
+            vector<Process> ref = base;
+            Timeline tick = runTickSimulator(choice, ref, tq);
+            for (auto &[name, kind] : engineNames) {
+                if (kind == EngineKind::Tick || !engineSupports(kind, choice, w)) continue;
+                vector<Process> full = base, compact = base;
+                ++checks;
+                Schedule s = runEngineKind(kind, choice, full, tq, w);
+                if (toTimeline(s) != tick || !sameProcesses(full, ref)) fail(name + " vs tick: " + run);
+                ++checks;
+                Schedule c = runEngineKind(kind, choice, compact, tq, w, true);
+                if (!sameProcesses(compact, ref) || countContextSwitches(c) != countContextSwitches(tick))
+                    fail(name + " compact vs tick: " + run);
+            }
+            // the tick simulators ignore the knobs, so the engines are checked against each other
+            contextSwitchCost = 2, preemptThreshold = 2, minGranularity = 3;
+            vector<Process> heapProcs = base;
+            Schedule heap = runEngineKind(EngineKind::DaryHeap, choice, heapProcs, tq, w);
+            for (auto &[name, kind] : engineNames) {
+                if (kind == EngineKind::Tick || kind == EngineKind::DaryHeap || !engineSupports(kind, choice, w))
+                    continue;
+                vector<Process> procs = base;
+                ++checks;
+                if (!sameSchedule(runEngineKind(kind, choice, procs, tq, w), heap) || !sameProcesses(procs, heapProcs))
+                    fail(name + " vs dary with knobs: " + run);
+            }
+        }
+    }
+    contextSwitchCost = savedCost, preemptThreshold = savedThr, minGranularity = savedGran;
+
+    // Bursts and priorities past 2^21, where a narrower key packing would overflow
+    // (the SRTF pair must preempt P1 at time 1 and switch twice)
+    auto make = [](int pid, int arrival, int burst, int priority) {
+        Process p;
+        p.pid = pid, p.arrival = arrival, p.burst = p.remaining = burst, p.priority = priority;
+        return p;
+    };
+    vector<vector<Process>> wide = {
+        {make(1, 0, 2100000, 1), make(2, 1, 2000000, 1)},
+        {make(1, 0, 2100000, 3000000), make(2, 1, 2000000, -3000000), make(3, 2, 5, 3000000)},
+    };
+    contextSwitchCost = preemptThreshold = minGranularity = 0;
+    for (auto &base : wide) {
+        WorkloadShape w = inspectWorkload(base);
+        for (int choice : {2, 3}) {
+            string run = policyName(choice, 1) + ", bursts past 2^21";
+            vector<Process> ref = base;
+            Timeline tick = runTickSimulator(choice, ref, 1);
+            ++checks;
+            if (choice == 2 && base.size() == 2 && (countContextSwitches(tick) != 2 || ref[0].completion != 4100000))
+                fail("tick: " + run);
+            for (auto &[name, kind] : engineNames) {
+                if (kind == EngineKind::Tick || !engineSupports(kind, choice, w)) continue;
+                vector<Process> procs = base;
+                ++checks;
+                if (toTimeline(runEngineKind(kind, choice, procs, 1, w)) != tick || !sameProcesses(procs, ref))
+                    fail(name + " vs tick: " + run);
+            }
+        }
+    }
+    contextSwitchCost = savedCost, preemptThreshold = savedThr, minGranularity = savedGran;
+
+    // EEVDF: treap pick against a linear scan over the same state
+    for (int n : {1, 50, 3000}) {
+        mt19937 rng(n);
+        vector<int> weight(n);
+        vector<long long> v(n), vd(n);
+        __int128 sum = 0;
+        long long total = 0;
+        EligibilityTree tree;
+        tree.reset(n);
+        for (int i = 0; i < n; ++i) {
+            weight[i] = niceWeights[rng() % 20];
+            v[i] = rng() % 4 == 0 ? 0 : (long long)(rng() % 1000) * EEVDFScale;
+            vd[i] = v[i] + 3 * EEVDFScale / weight[i];
+            tree.insert(i, v[i], vd[i]);
+            sum += (__int128)weight[i] * v[i];
+            total += weight[i];
+        }
+        for (int d = 0; d < 20000; ++d) {
+            int best = -1;
+            for (int i = 0; i < n; ++i)
+                if ((__int128)v[i] * total <= sum && (best < 0 || vd[i] < vd[best])) best = i;
+            int pick = tree.pickEligible(sum, total);
+            ++checks;
+            if (pick != best) { fail("EEVDF pick, n=" + to_string(n) + " decision " + to_string(d)); break; }
+            tree.erase(pick);
+            long long step = (long long)(1 + rng() % 5) * EEVDFScale / weight[pick];
+            v[pick] += step;
+            if (v[pick] >= vd[pick]) vd[pick] = v[pick] + 3 * EEVDFScale / weight[pick];
+            sum += (__int128)weight[pick] * step;
+            tree.insert(pick, v[pick], vd[pick]);
+        }
+    }
+
+    cout << "Self-test: " << checks << " checks, " << failures << " failed\n";
+    return failures;
+}
+
+int main(int argc, char **argv) {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    // Command-line flags:
+    //   --engine=<auto|tick|fifo|linear|bucket|binary|dary|pairing|skiplist|rbtree>
+    //   --switch-cost=<time units charged per context switch>
+    //   --preempt-threshold=<key margin a newcomer needs to preempt (SRTF/Priority)>
+    //   --min-granularity=<minimum run time before preemption (SRTF/Priority)>
+    //   --slo=<class>:<max turnaround>[:<percent>] (repeatable)
+    //   --reservation=<class>:<budget>/<period>[:hard|soft] (repeatable)
+    //   --calibrate=<file> (measure this host, write the file and exit)
+    //   --calibration=<file> (switch cost from a calibration file)
+    //   --selftest (check the engines against the reference simulators and exit)
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("--switch-cost=", 0) == 0) {
+            contextSwitchCost = max(0, atoi(arg.c_str() + 14));
+        } else if (arg.rfind("--preempt-threshold=", 0) == 0) {
+            preemptThreshold = max(0, atoi(arg.c_str() + 20));
+        } else if (arg.rfind("--min-granularity=", 0) == 0) {
+            minGranularity = max(0, atoi(arg.c_str() + 18));
+        } else if (arg.rfind("--slo=", 0) == 0) {
+            if (!parseSLOFlag(arg.substr(6))) { cerr << "Invalid SLO: " << arg << "\n"; return 1; }
+        } else if (arg.rfind("--reservation=", 0) == 0) {
+            if (!parseReservationFlag(arg.substr(14))) { cerr << "Invalid reservation: " << arg << "\n"; return 1; }
+        } else if (arg.rfind("--calibrate=", 0) == 0) {
+            try {
+                Calibration c = calibrateHost();
+                writeCalibration(c, arg.substr(12));
+                cout << "Wrote " << arg.substr(12) << ":\n";
+                printCalibration(c);
+                return 0;
+            } catch (const exception &e) { cerr << e.what() << "\n"; return 1; }
+        } else if (arg.rfind("--calibration=", 0) == 0) {
+            try {
+                Calibration c = readCalibration(arg.substr(14));
+                contextSwitchCost = calibratedSwitchCost(c);
+                cout << "Calibrated switch cost: " << contextSwitchCost << " time units of " << c.timeUnitNs << " ns\n";
+            } catch (const exception &e) { cerr << e.what() << "\n"; return 1; }
+        } else if (arg == "--selftest") {
+            return runSelfTest() == 0 ? 0 : 1;
+        } else if (arg.rfind("--engine=", 0) == 0) {
+            string name = arg.substr(9);
+            auto it = find_if(engineNames.begin(), engineNames.end(), [&](const pair<string, EngineKind> &e){ return e.first == name; });
+            if (it == engineNames.end()) { cerr << "Unknown engine: " << name << "\n"; return 1; }
+            engineOverride = it->second;
+        } else {
+            cerr << "Unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    cout << "System Scheduler Simulator - Professional Edition (C++17)\n";
+    cout << "Options:\n1) Input from console\n2) Input from CSV file (pid,arrival,burst,priority[,class])\n"
+         << "3) Generate random workload\n4) Approximate run over a large CSV trace (streamed and sampled)\n"
+         << "5) Bounded-memory run over a CSV trace (results spilled to disk)\n"
+         << "Choose input mode (1/2/3/4/5): ";
+    int mode;
+    cin >> mode;
+    vector<Process> procs;
+    if (mode == 2) {
+        cout << "Enter CSV file path: ";
+        string path; cin >> path;
+        procs = readFromCSV(path);
+        if (procs.empty()) {
+            cout << "Failed to read CSV or file empty. Exiting.\n";
+            return 1;
+        }
+    } else if (mode == 4) {
+        cout << "Enter CSV file path: ";
+        string path; cin >> path;
+        int policy = readPositiveInt("Policy (1=FCFS, 2=SRTF, 3=Priority, 4=RR): ");
+        int tq = policy == 4 ? readQuantum() : 1;
+        double fraction = min(1.0, readPositiveDouble("Sampling fraction (0-1]: "));
+        int replicas = readPositiveInt("Replicas: ");
+        runStreamingApproximation(path, policy, tq, fraction, replicas);
+        cout << "Simulation complete.\n";
+        return 0;
+    } else if (mode == 5) {
+        cout << "Enter CSV file path (sorted by arrival, pid): ";
+        string path; cin >> path;
+        int policy = readPositiveInt("Policy (1=FCFS, 2=SRTF, 3=Priority, 4=RR): ");
+        int tq = policy == 4 ? readQuantum() : 1;
+        int budgetMB = readPositiveInt("Memory budget (MB): ");
+        cout << "Spill file prefix: ";
+        string prefix; cin >> prefix;
+        cout << "=== Bounded-memory " << policyName(policy, tq) << " ===\n";
+        Metrics m;
+        if (!runBoundedMemory(path, policy, tq, (size_t)budgetMB << 20, prefix, m)) return 1;
+        printSummary(m);
+        querySpill(prefix);
+        cout << "Simulation complete.\n";
+        return 0;
+    } else if (mode == 3) {
+        int n = readPositiveInt("Number of processes: ");
+        double load = readPositiveDouble("Offered load (e.g. 0.8): ");
+        int maxBurst = readPositiveInt("Maximum burst: ");
+        int levels = readPositiveInt("Priority levels: ");
+        int seed = readPositiveInt("Random seed: ");
+        procs = generateWorkload(n, load, maxBurst, levels, (unsigned)seed);
+    } else {
+        procs = readFromConsole();
+    }
+
+    // Sort by pid to preserve consistent reporting
+    sort(procs.begin(), procs.end(), [](const Process &a, const Process &b){ return a.pid < b.pid; });
+
+    // Provide an option to run all algorithms or selected ones
+    cout << "\nSelect algorithms to run (e.g., 1 2 3 4) or 0 for all:\n"
+         << "1: FCFS\n2: SRTF (preemptive SJF)\n3: Preemptive Priority\n4: Round Robin\n5: EEVDF\nChoice: ";
+    string line;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    getline(cin, line);
+    vector<int> choices;
+    if (line.empty() || line == "0") { choices = {1,2,3,4,5}; }
+    else {
+        stringstream ss(line);
+        int x;
+        while (ss >> x) choices.push_back(x);
+    }
+
+    // Run chosen algorithms
+    for (int c : choices) {
+        if (c == 1) {
+            auto copyP = procs;
+            resetProcesses(copyP);
+            FCFS(copyP);
+            cout << "---------------------------------------------\n";
+        } else if (c == 2) {
+            auto copyP = procs;
+            resetProcesses(copyP);
+            SRTF(copyP);
+            cout << "---------------------------------------------\n";
+        } else if (c == 3) {
+            auto copyP = procs;
+            resetProcesses(copyP);
+            PreemptivePriority(copyP);
+            cout << "---------------------------------------------\n";
+        } else if (c == 4) {
+            auto copyP = procs;
+            resetProcesses(copyP);
+            int tq = readQuantum();
+            RoundRobin(copyP, tq);
+            cout << "---------------------------------------------\n";
+        } else if (c == 5) {
+            auto copyP = procs;
+            resetProcesses(copyP);
+            EEVDF(copyP, readPositiveInt("Enter EEVDF base slice (positive integer): "));
+            cout << "---------------------------------------------\n";
+        } else {
+            cout << "Unknown choice: " << c << "\n";
+        }
+    }
+
+    // Optional analyses over the same workload
+    cout << "\nSelect analyses to run (e.g., 1 2) or 0 for none:\n"
+         << "1: Run-queue lock contention (global vs per-CPU, 1..256 CPUs)\n"
+         << "2: Ready-queue trace export and data-structure replay benchmark\n"
+         << "3: Relaxed priority scheduling (MultiQueue benchmark and quality loss)\n"
+         << "4: Engine chooser benchmark (all ready-queue engines vs the automatic pick)\n"
+         << "5: Approximate simulation by sampling (estimates with 95% confidence intervals)\n"
+         << "6: Latency breakdown by policy (queueing / preempted / context-switch overhead)\n"
+         << "7: Preemption threshold / minimum granularity sweep (SRTF and Priority)\n"
+         << "8: Per-class SLO report (class column in the CSV, targets from --slo)\n"
+         << "9: Mixed-criticality periodic tasks (EDF-VD and AMC with mode switches)\n"
+         << "10: Processor sharing / GPS fluid reference vs Round Robin quantum sweep\n"
+         << "11: EEVDF pick benchmark (augmented tree vs linear scan, up to 2M runnable)\n"
+         << "12: Size-based policies for unknown sizes (Gittins, FB/LAS, SRPT with noisy estimates)\n"
+         << "13: Closed-loop clients with think times (throughput and response vs population)\n"
+         << "14: Timeouts, abandonment and retries (amplification and goodput vs offered load)\n"
+         << "15: CBS reservations (--reservation classes, or generated servers with background work)\n"
+         << "16: Adversarial workload search (worst case of one policy, minimized CSV reproducer)\n"
+         << "17: Perturbation sensitivity (burst noise, arrival jitter, priority swaps; variance and elasticity)\n"
+         << "18: Fixed-capacity bitset engine benchmark (n <= 512, against the growable engines)\n"
+         << "19: Real-kernel comparison (Linux threads pinned to one CPU vs the simulated policies)\n"
+         << "20: Memory-bandwidth and shared-cache interference on multiple CPUs (placement policies)\n"
+         << "21: Lower bounds and optimality gaps (SRPT and load bounds, exact B&B for tiny instances)\n"
+         << "22: Scripted processes as C++20 coroutines (compute, locks, I/O, sleep, spawn)\n"
+         << "Choice: ";
+    vector<int> analyses;
+    if (cin >> ws && getline(cin, line)) {
+        stringstream ss(line);
+        int x;
+        while (ss >> x) if (x != 0) analyses.push_back(x);
+    }
+    for (int a : analyses) {
+        if (a == 1) {
+            int tq = readQuantum();
+            double hold = readPositiveDouble("Lock hold time per queue operation (time units, e.g. 0.01): ");
+            int balanceEvery = readPositiveInt("Per-CPU balancing interval (dispatches): ");
+            runLockContentionModel(procs, tq, hold, balanceEvery);
+            cout << "---------------------------------------------\n";
+        } else if (a == 2) {
+            int policy = readPositiveInt("Policy to trace (1=FCFS, 2=SRTF, 3=Priority, 4=RR): ");
+            int tq = policy == 4 ? readQuantum() : 1;
+            cout << "Trace CSV output path (- to skip export): ";
+            string path;
+            cin >> path;
+            runReadyQueueBenchmark(procs, policy, tq, path);
+            cout << "---------------------------------------------\n";
+        } else if (a == 3) {
+            runRelaxedPriorityAnalysis(procs);
+            cout << "---------------------------------------------\n";
+        } else if (a == 4) {
+            runEngineChooserBenchmark(procs, readQuantum());
+            cout << "---------------------------------------------\n";
+        } else if (a == 5) {
+            int policy = readPositiveInt("Policy (1=FCFS, 2=SRTF, 3=Priority, 4=RR): ");
+            int tq = policy == 4 ? readQuantum() : 1;
+            int method = readPositiveInt("Sampling method (1=thinned arrivals, 2=random windows): ");
+            double fraction = 1.0;
+            int windowSize = 0;
+            if (method == 2) windowSize = readPositiveInt("Window size (processes): ");
+            else fraction = min(1.0, readPositiveDouble("Sampling fraction (0-1]: "));
+            int replicas = readPositiveInt("Replicas: ");
+            runApproximateAnalysis(procs, policy, tq, method == 2, fraction, windowSize, replicas);
+            cout << "---------------------------------------------\n";
+        } else if (a == 6) {
+            int tq = readQuantum();
+            cout << "Context-switch cost (time units, 0 for none): ";
+            int cost = 0;
+            cin >> cost;
+            runLatencyBreakdown(procs, tq, max(0, cost));
+            cout << "---------------------------------------------\n";
+        } else if (a == 7) {
+            cout << "Context-switch cost (time units, 0 for none): ";
+            int cost = 0;
+            cin >> cost;
+            runPreemptionSweep(procs, max(0, cost));
+            cout << "---------------------------------------------\n";
+        } else if (a == 8) {
+            runClassReport(procs, readQuantum());
+            cout << "---------------------------------------------\n";
+        } else if (a == 9) {
+            cout << "Task set CSV (name,period,deadline,crit,clo,chi) or - to generate: ";
+            string path;
+            cin >> path;
+            vector<MCTask> tasks;
+            if (path == "-") {
+                int n = readPositiveInt("Number of tasks: ");
+                double util = readPositiveDouble("LO-mode utilization (e.g. 0.7): ");
+                tasks = generateMCTasks(n, util, (unsigned)readPositiveInt("Random seed: "));
+            } else {
+                try { tasks = readMCTasks(path); }
+                catch (const exception &e) { cout << e.what() << "\n"; continue; }
+            }
+            int horizon = readPositiveInt("Horizon (time units): ");
+            cout << "Probability that a HI job overruns its LO budget (0-1): ";
+            double prob = 0;
+            cin >> prob;
+            runMixedCriticality(tasks, horizon, prob, 12345);
+            cout << "---------------------------------------------\n";
+        } else if (a == 10) {
+            runProcessorSharingReference(procs);
+            cout << "---------------------------------------------\n";
+        } else if (a == 11) {
+            runEEVDFBenchmark(readPositiveInt("EEVDF base slice: "));
+            cout << "---------------------------------------------\n";
+        } else if (a == 12) {
+            runSizeBasedComparison(procs, readQuantum());
+            cout << "---------------------------------------------\n";
+        } else if (a == 13) {
+            int tq = readQuantum();
+            double think = readPositiveDouble("Mean think time: ");
+            int maxClients = readPositiveInt("Largest population (1 for automatic): ");
+            runClosedLoop(procs, tq, think, maxClients == 1 ? 0 : maxClients, 20000);
+            cout << "---------------------------------------------\n";
+        } else if (a == 14) {
+            int tq = readQuantum();
+            RetryConfig cfg;
+            cfg.timeout = readPositiveInt("Client timeout: ");
+            cfg.attempts = readPositiveInt("Attempts per request (1 = no retries): ");
+            int backoff = 0;
+            while (backoff < 1 || backoff > 3)
+                backoff = readPositiveInt("Retry backoff (1: immediate, 2: exponential, 3: exponential with jitter): ");
+            cfg.backoff = (RetryBackoff)backoff;
+            if (cfg.backoff != RetryBackoff::Immediate) cfg.base = readPositiveInt("Backoff base: ");
+            runRetryStorm(procs, tq, cfg);
+            cout << "---------------------------------------------\n";
+        } else if (a == 15) {
+            if (!classReservations.empty()) {
+                runClassReservations(procs);
+            } else {
+                int servers = readPositiveInt("No --reservation flags; number of generated servers: ");
+                vector<Reservation> rsv;
+                vector<int> serverOf;
+                vector<Process> jobs = generateReservedWorkload(servers, 0.7, 0.9, 0.2, 42, rsv, serverOf);
+                vector<string> names;
+                for (int s = 0; s < servers; ++s) names.push_back("cbs" + to_string(s + 1));
+                runReservations(jobs, serverOf, rsv, names, true);
+            }
+            cout << "---------------------------------------------\n";
+        } else if (a == 16) {
+            int choice = 0, metric = 0;
+            while (choice < 1 || choice > 4) choice = readPositiveInt("Policy (1: FCFS, 2: SRTF, 3: Priority, 4: RR): ");
+            int tq = choice == 4 ? readQuantum() : 1;
+            while (metric < 1 || metric > 3)
+                metric = readPositiveInt("Maximize (1: max waiting, 2: context switches, 3: p99 response): ");
+            SearchBounds b;
+            b.processes = readPositiveInt("Processes: ");
+            b.latestArrival = readPositiveInt("Latest arrival: ");
+            b.largestBurst = readPositiveInt("Largest burst: ");
+            b.priorityLevels = readPositiveInt("Priority levels: ");
+            long long perThread = readPositiveInt("Evaluations per thread: ");
+            cout << "Reproducer CSV path (- to skip): ";
+            string path;
+            cin >> path;
+            runAdversarialSearch(choice, tq, (AdversaryMetric)metric, b, perThread, path);
+            cout << "---------------------------------------------\n";
+        } else if (a == 17) {
+            int tq = readQuantum();
+            double sigma = readPositiveDouble("Burst noise sigma (e.g. 0.2): ");
+            double jitter = readPositiveDouble("Arrival jitter, fraction of the mean inter-arrival gap (e.g. 0.5): ");
+            double swaps = readPositiveDouble("Fraction of rows swapping priorities (e.g. 0.1): ");
+            runSensitivityAnalysis(procs, tq, sigma, jitter, min(1.0, swaps), readPositiveInt("Replicas: "));
+            cout << "---------------------------------------------\n";
+        } else if (a == 18) {
+            runBitsetEngineBenchmark(readQuantum());
+            cout << "---------------------------------------------\n";
+        } else if (a == 19) {
+            int tq = readQuantum();
+            double unitMs = readPositiveDouble("Milliseconds per time unit (e.g. 5): ");
+            int kernelPolicy = 0;
+            while (kernelPolicy < 1 || kernelPolicy > 3)
+                kernelPolicy = readPositiveInt("Kernel policy (1: SCHED_OTHER with nice, 2: SCHED_RR, 3: SCHED_FIFO): ");
+            try { runKernelComparison(procs, kernelPolicy, unitMs, tq); }
+            catch (const exception &e) { cout << e.what() << "\n"; }
+            cout << "---------------------------------------------\n";
+        } else if (a == 20) {
+            int tq = readQuantum();
+            MemoryModel mm;
+            mm.sockets = readPositiveInt("Sockets: ");
+            mm.coresPerSocket = readPositiveInt("Cores per socket: ");
+            mm.bandwidth = readPositiveDouble("Memory bandwidth per socket, in fully memory-bound cores (e.g. 2): ");
+            mm.llc = readPositiveDouble("Shared-cache sensitivity (e.g. 0.5): ");
+            runInterferenceAnalysis(procs, mm, tq);
+            cout << "---------------------------------------------\n";
+        } else if (a == 21) {
+            int tq = readQuantum();
+            runOptimalityGaps(procs, tq, readPositiveInt("CPUs for the multi-CPU bounds (1 for none): "), 14);
+            cout << "---------------------------------------------\n";
+        } else if (a == 22) {
+#if __cplusplus >= 202002L
+            int tq = readQuantum();
+            long long count = readPositiveInt("Scripted processes (workload rows reused cyclically): ");
+            runScriptedProcesses(procs, tq, count, readPositiveInt("Locks: "));
+#else
+            cout << "Scripted processes need a C++20 build (-std=c++20)\n";
+#endif
+            cout << "---------------------------------------------\n";
+        } else {
+            cout << "Unknown analysis: " << a << "\n";
+        }
+    }
+
+    cout << "Simulation complete.\n";
+    return 0;
+}